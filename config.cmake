@@ -279,6 +279,52 @@ config_string(
     DEFAULT 100
     UNQUOTE
 )
+config_option(
+    KernelFastRevoke KERNEL_FAST_REVOKE
+    "Detach child capabilities that need no finalisation directly during revocation \
+    instead of deleting them one at a time through the generic delete path. \
+    Copies of an object that needs no finalisation, e.g. of an endpoint, are \
+    unlinked from the derivation tree a batch at a time. \
+    This speeds up revoking large derivation trees, e.g. badged endpoints."
+    DEFAULT OFF
+    DEPENDS "NOT KernelVerificationBuild"
+)
+config_string(
+    KernelRevokeBatchSize REVOKE_BATCH_SIZE
+    "Number of trivially deletable child capabilities that are detached during revocation \
+    before a single work unit is charged towards KernelMaxNumWorkUnitsPerPreemption."
+    DEFAULT 16
+    UNQUOTE
+    DEPENDS "KernelFastRevoke"
+    UNDEF_DISABLED
+)
+config_option(
+    KernelFrameMapRange FRAME_MAP_RANGE
+    "Provide a MapRange invocation on VSpace roots that maps a window of frame \
+    capabilities to a contiguous virtual range, performing a single cache and TLB \
+    maintenance pass for the whole range instead of one per frame. The frames are \
+    small frames, or on AArch64 frames of any one size. With KernelIOMMU on x86, \
+    IOSpaces provide the same invocation for IO address ranges."
+    DEFAULT OFF
+    DEPENDS "NOT KernelVerificationBuild; KernelSel4ArchAarch64 OR KernelSel4ArchX86_64 OR KernelArchRiscV"
+)
+config_string(
+    KernelMapRangeMaxFrames MAP_RANGE_MAX_FRAMES
+    "Maximum number of frames that a single MapRange invocation may map."
+    DEFAULT 256
+    UNQUOTE
+    DEPENDS "KernelFrameMapRange"
+    UNDEF_DISABLED
+)
+config_option(
+    KernelVCPURegBatch VCPU_REG_BATCH
+    "Provide invocations on VCPUs that read or write up to seL4_VCPURegBatchSize \
+    registers in a single call: ReadRegsBatch and WriteRegsBatch on Arm, \
+    ReadVMCSBatch and WriteVMCSBatch on x86."
+    DEFAULT OFF
+    DEPENDS "NOT KernelVerificationBuild; KernelArmHypervisorSupport OR KernelVTX"
+    DEFAULT_DISABLED OFF
+)
 config_string(
     KernelResetChunkBits RESET_CHUNK_BITS
     "Maximum size in bits of chunks of memory to zero before checking a preemption point."
@@ -424,12 +470,22 @@ config_choice(
     track_kernel_entries -> Log kernel entries information including timing, number of invocations and arguments for \
     system calls, interrupts, user faults and VM faults. \
     tracepoints -> Enable manually inserted tracepoints that the kernel will track time consumed between. \
-    track_utilisation -> Enable the kernel to track each thread's utilisation time."
+    track_utilisation -> Enable the kernel to track each thread's utilisation time. \
+    sample_profile -> Sample the program counter of the running thread into the log buffer \
+    on every PMU overflow interrupt. \
+    irq_latency -> Aggregate the latencies of handling each IRQ, from kernel entry to \
+    signalling its notification and to the woken thread running, in the log buffer. \
+    sched_trace -> Log thread switches, wakeups, blocking, domain switches and MCS budget \
+    events with timestamps in the log buffer. tools/sched_trace_json.py converts the log \
+    to the Chrome trace event format."
     "none;KernelBenchmarksNone;NO_BENCHMARKS"
     "generic;KernelBenchmarksGeneric;BENCHMARK_GENERIC;NOT KernelVerificationBuild"
     "track_kernel_entries;KernelBenchmarksTrackKernelEntries;BENCHMARK_TRACK_KERNEL_ENTRIES;NOT KernelVerificationBuild"
     "tracepoints;KernelBenchmarksTracepoints;BENCHMARK_TRACEPOINTS;NOT KernelVerificationBuild"
     "track_utilisation;KernelBenchmarksTrackUtilisation;BENCHMARK_TRACK_UTILISATION;NOT KernelVerificationBuild"
+    "sample_profile;KernelBenchmarksSampleProfile;BENCHMARK_SAMPLE_PROFILE;NOT KernelVerificationBuild;KernelArchARM OR KernelArchX86"
+    "irq_latency;KernelBenchmarksIRQLatency;BENCHMARK_IRQ_LATENCY;NOT KernelVerificationBuild"
+    "sched_trace;KernelBenchmarksSchedTrace;BENCHMARK_SCHED_TRACE;NOT KernelVerificationBuild"
 )
 if(NOT (KernelBenchmarks STREQUAL "none"))
     config_set(KernelEnableBenchmarks ENABLE_BENCHMARKS ON)
@@ -438,7 +494,13 @@ else()
 endif()
 
 # Reflect the existence of kernel Log buffer
-if(KernelBenchmarksTrackKernelEntries OR KernelBenchmarksTracepoints)
+if(
+    KernelBenchmarksTrackKernelEntries
+    OR KernelBenchmarksTracepoints
+    OR KernelBenchmarksSampleProfile
+    OR KernelBenchmarksIRQLatency
+    OR KernelBenchmarksSchedTrace
+)
     config_set(KernelLogBuffer KERNEL_LOG_BUFFER ON)
 else()
     config_set(KernelLogBuffer KERNEL_LOG_BUFFER OFF)
@@ -454,6 +516,104 @@ config_string(
     UNQUOTE
 )
 
+config_option(
+    KernelBenchmarksTrackKernelEntriesRing BENCHMARK_TRACK_KERNEL_ENTRIES_RING
+    "Split the log buffer into one ring buffer of kernel entries per core instead \
+    of filling a single log once. Each ring has a head index advanced by the \
+    kernel and a tail index advanced by a user-level consumer, so the log can be \
+    drained while the system runs. Entries are counted as dropped while a ring is full."
+    DEFAULT OFF
+    DEPENDS "KernelBenchmarksTrackKernelEntries"
+    DEFAULT_DISABLED OFF
+)
+
+config_option(
+    KernelBenchmarksTrackKernelEntriesHistogram BENCHMARK_TRACK_KERNEL_ENTRIES_HISTOGRAM
+    "Aggregate the durations of kernel entries into log-linear histograms instead \
+    of logging every entry. The log buffer holds one table of histograms per core, \
+    keyed by entry path, and for syscalls by syscall number, cap type and \
+    invocation label. Each histogram also records the longest duration and when \
+    it started."
+    DEFAULT OFF
+    DEPENDS "KernelBenchmarksTrackKernelEntries;NOT KernelBenchmarksTrackKernelEntriesRing"
+    DEFAULT_DISABLED OFF
+)
+
+config_option(
+    KernelBenchmarksTrackUtilisationPMU BENCHMARK_TRACK_UTILISATION_PMU
+    "In the track_utilisation benchmark mode, also count the PMU events listed in \
+    KernelBenchmarksTrackUtilisationPMUEvents for each thread, separately for the \
+    time it runs at user level and the time the kernel runs on its behalf."
+    DEFAULT OFF
+    DEPENDS "KernelBenchmarksTrackUtilisation;KernelArchARM"
+    DEFAULT_DISABLED OFF
+)
+
+config_string(
+    KernelBenchmarksTrackUtilisationPMUEvents BENCHMARK_TRACK_UTILISATION_PMU_EVENTS
+    "Comma separated list of the architectural PMU event numbers to count per thread, \
+    using one event counter each. The default counts instructions retired, L1 data \
+    cache refills, L2 data cache refills, L1 data TLB refills and mispredicted branches."
+    DEFAULT "0x08,0x03,0x17,0x05,0x10"
+    UNQUOTE
+    DEPENDS "KernelBenchmarksTrackUtilisationPMU"
+    UNDEF_DISABLED
+)
+
+config_string(
+    KernelBenchmarksTrackUtilisationSchedContexts BENCHMARK_TRACK_UTILISATION_SCHED_CONTEXTS
+    "In the track_utilisation benchmark mode, the number of scheduling contexts each \
+    core keeps utilisation counters for. Scheduling contexts that run once the table \
+    of a core is full are not accounted on that core."
+    DEFAULT 64
+    UNQUOTE
+    DEPENDS "KernelBenchmarksTrackUtilisation;KernelIsMCS"
+    UNDEF_DISABLED
+)
+
+config_string(
+    KernelBenchmarksSampleProfilePeriod BENCHMARK_SAMPLE_PROFILE_PERIOD
+    "In the sample_profile benchmark mode, the number of CPU cycles between two \
+    samples on each core. Must be below 2^31."
+    DEFAULT 1000000
+    UNQUOTE
+    DEPENDS "KernelBenchmarksSampleProfile"
+    UNDEF_DISABLED
+)
+
+config_string(
+    KernelBenchmarksSampleProfileUserFrames BENCHMARK_SAMPLE_PROFILE_USER_FRAMES
+    "In the sample_profile benchmark mode, the number of return addresses of \
+    enclosing user-level stack frames recorded with each sample. They are found \
+    by following the frame pointer chain of the interrupted thread, so user code \
+    must be compiled with frame pointers. Only supported on aarch64 and x86_64."
+    DEFAULT 0
+    UNQUOTE
+    DEPENDS "KernelBenchmarksSampleProfile;KernelSel4ArchAarch64 OR KernelSel4ArchX86_64"
+    DEFAULT_DISABLED 0
+)
+
+config_option(
+    KernelBenchmarksFastpathCounters BENCHMARK_FASTPATH_COUNTERS
+    "Count, per core, how often the call, reply_recv and signal fastpaths complete \
+    a syscall and how often each of their checks sends it to the slowpath instead. \
+    The counters are read with seL4_BenchmarkGetFastpathCounters."
+    DEFAULT OFF
+    DEPENDS "KernelEnableBenchmarks;KernelFastpath"
+    DEFAULT_DISABLED OFF
+)
+
+config_option(
+    KernelBenchmarksPreemptionLatency BENCHMARK_PREEMPTION_LATENCY
+    "Instrument preemption points and long-running kernel operations. For each \
+    operation, count preemption points, interrupt checks and preemptions, and record \
+    the longest time spent in the kernel without reaching a preemption point or \
+    checking for interrupts. The counters are read with seL4_BenchmarkGetPreemptionCounters."
+    DEFAULT OFF
+    DEPENDS "KernelEnableBenchmarks"
+    DEFAULT_DISABLED OFF
+)
+
 config_option(
     KernelIRQReporting IRQ_REPORTING
     "seL4 does not properly check for and handle spurious interrupts. This can result \
@@ -34,9 +34,14 @@ extern pte_t armKSGlobalKernelPT[BIT(PT_INDEX_BITS)] VISIBLE;
 
 #ifdef CONFIG_ARM_HYPERVISOR_SUPPORT
 
+#ifdef CONFIG_ARM_HYP_VMID_ROLLOVER
+extern hw_asid_t armKSNextASID VISIBLE;
+extern hw_asid_t armKSReservedHWASIDs[CONFIG_MAX_NUM_NODES] VISIBLE;
+#else
 extern asid_t armKSHWASIDTable[BIT(hwASIDBits)] VISIBLE;
 extern hw_asid_t armKSNextASID VISIBLE;
 #endif
+#endif
 
 #ifdef CONFIG_KERNEL_LOG_BUFFER
 extern pte_t *armKSGlobalLogPTE;
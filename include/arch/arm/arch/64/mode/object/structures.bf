@@ -229,14 +229,22 @@ block asid_map_none {
 
 --- hw_vmids are required in hyp mode
 block asid_map_vspace {
-#ifdef CONFIG_ARM_SMMU
+#if defined(CONFIG_ARM_SMMU) && defined(CONFIG_ARM_HYP_VMID_16BIT)
+    field bind_cb                   8
+#elif defined(CONFIG_ARM_SMMU)
     field bind_cb                   8
     padding                         8
+#elif defined(CONFIG_ARM_HYP_VMID_16BIT)
+    padding                         8
 #else
     padding                         16
 #endif
     field_high vspace_root          36
-#ifdef CONFIG_ARM_HYPERVISOR_SUPPORT
+#ifdef CONFIG_ARM_HYP_VMID_16BIT
+    padding                         2
+    field stored_hw_vmid            16
+    field stored_vmid_valid         1
+#elif defined(CONFIG_ARM_HYPERVISOR_SUPPORT)
     padding                         2
     field stored_hw_vmid            8
     field stored_vmid_valid         1
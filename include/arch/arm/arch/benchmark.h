@@ -23,6 +23,22 @@
 #endif
 
 void arm_init_ccnt(void);
+#ifdef CONFIG_BENCHMARK_TRACK_UTILISATION_PMU
+bool_t arm_init_pmu_events(void);
+
+static inline uint32_t benchmark_arch_pmu_read(word_t counter)
+{
+    word_t val;
+    SYSTEM_WRITE_WORD(PMSELR, counter);
+    isb();
+    SYSTEM_READ_WORD(PMXEVCNTR, val);
+    return val;
+}
+#endif /* CONFIG_BENCHMARK_TRACK_UTILISATION_PMU */
+#ifdef CONFIG_BENCHMARK_SAMPLE_PROFILE
+bool_t arm_init_pmu_sampling(void);
+void arm_handle_sample_overflow(void);
+#endif /* CONFIG_BENCHMARK_SAMPLE_PROFILE */
 
 static inline timestamp_t timestamp(void)
 {
@@ -129,6 +129,7 @@
 #define VGIC_VTR_NLISTREGS(vtr)         ((((vtr) >>  0) & 0x3f) + 1)
 #define VGIC_VTR_NPRIOBITS(vtr)         ((((vtr) >> 29) & 0x07) + 1)
 #define VGIC_VTR_NPREBITS(vtr)          ((((vtr) >> 26) & 0x07) + 1)
+#define VGIC_LR_VINTID(lr)              ((lr) & 0xffffffff)
 
 /* Memory map for GIC distributor */
 struct gic_dist_map {
@@ -19,6 +19,7 @@ NODE_STATE_DECLARE(word_t, ipiReschedulePending);
 #ifdef CONFIG_ARM_HYPERVISOR_SUPPORT
 NODE_STATE_DECLARE(vcpu_t, *armHSCurVCPU);
 NODE_STATE_DECLARE(bool_t, armHSVCPUActive);
+NODE_STATE_DECLARE(uint64_t, armHSVGICLRDirty);
 #if defined(CONFIG_ARCH_AARCH32) && defined(CONFIG_HAVE_FPU)
 NODE_STATE_DECLARE(bool_t, armHSFPUEnabled);
 #endif
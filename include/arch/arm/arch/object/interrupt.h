@@ -26,6 +26,13 @@ static inline void handleReservedIRQ(irq_t irq)
     }
 #endif /* CONFIG_ARM_ENABLE_PMU_OVERFLOW_INTERRUPT */
 
+#ifdef CONFIG_BENCHMARK_SAMPLE_PROFILE
+    if (IRQT_TO_IRQ(irq) == KERNEL_PMU_IRQ) {
+        arm_handle_sample_overflow();
+        return;
+    }
+#endif /* CONFIG_BENCHMARK_SAMPLE_PROFILE */
+
 #ifdef CONFIG_ARM_HYPERVISOR_SUPPORT
     if (IRQT_TO_IRQ(irq) == INTERRUPT_VGIC_MAINTENANCE) {
         VGICMaintenance();
@@ -32,4 +32,5 @@ exception_t smmu_delete_sid(cap_t cap);
 void smmu_cb_delete_vspace(word_t cb, asid_t asid);
 void invalidateSMMUTLBByASID(asid_t asid, word_t bind_cb);
 void invalidateSMMUTLBByASIDVA(asid_t asid, vptr_t vaddr, word_t bind_cb);
+void invalidateSMMUTLBByASIDRange(asid_t asid, vptr_t vaddr, word_t npages, word_t pageBits, word_t bind_cb);
 
@@ -55,9 +55,27 @@ struct gicVCpuIface {
     /* virq_t[] requires word-size alignment; add extra padding for
      * 64-bit platforms to make this struct packed. */
     uint32_t gicVCpuIface_padding;
+    /* Bit n is set if lr[n] may hold a pending or active interrupt, or one
+     * that still needs an EOI maintenance interrupt. Only these list
+     * registers are saved and restored on a VCPU switch. */
+    uint64_t lr_live;
+#ifdef CONFIG_ARM_HYP_VIRQ_ASYNC
+    /* Bit n is set if another core wrote lr[n] while the VCPU was loaded, and
+     * the hardware list register has not been updated yet */
+    uint64_t lr_posted;
+#endif
     virq_t lr[GIC_VCPU_MAX_NUM_LR];
 };
 
+#ifdef CONFIG_ARM_HYP_VIRQ_QUEUE
+/* Virtual interrupts waiting for a free list register, oldest first */
+struct virqQueue {
+    word_t head;
+    word_t count;
+    virq_t virqs[CONFIG_ARM_HYP_VIRQ_QUEUE_SIZE];
+};
+#endif
+
 #ifdef CONFIG_VTIMER_UPDATE_VOFFSET
 struct vTimer {
     uint64_t last_pcount;
@@ -71,6 +89,18 @@ enum VPPIEventIRQ {
 };
 typedef word_t VPPIEventIRQ_t;
 
+#ifdef CONFIG_ARM_HYP_VPPI_INJECT
+/* Virtual PPI events the kernel injects itself instead of raising a
+ * VPPIEvent fault */
+struct vppiInject {
+    /* The pending IRQ written to a list register, invalid if not enabled */
+    virq_t virq[n_VPPIEventIRQ];
+    /* The list register holding the injected IRQ while the PPI is masked */
+    word_t lr[n_VPPIEventIRQ];
+    bool_t in_lr[n_VPPIEventIRQ];
+};
+#endif
+
 struct vcpu {
     /* TCB associated with this VCPU. */
     struct tcb *vcpuTCB;
@@ -87,6 +117,12 @@ struct vcpu {
      */
     struct vTimer virtTimer;
 #endif
+#ifdef CONFIG_ARM_HYP_VIRQ_QUEUE
+    struct virqQueue virqQueue;
+#endif
+#ifdef CONFIG_ARM_HYP_VPPI_INJECT
+    struct vppiInject vppiInject;
+#endif
 };
 typedef struct vcpu vcpu_t;
 compile_assert(vcpu_size_correct, sizeof(struct vcpu) <= BIT(VCPU_SIZE_BITS))
@@ -121,6 +157,12 @@ void vcpu_restore(vcpu_t *cpu);
 void vcpu_switch(vcpu_t *cpu);
 #ifdef ENABLE_SMP_SUPPORT
 void handleVCPUInjectInterruptIPI(vcpu_t *vcpu, unsigned long index, virq_t virq);
+#ifdef CONFIG_ARM_HYP_VIRQ_QUEUE
+void handleVCPUQueueInterruptIPI(vcpu_t *vcpu, virq_t virq);
+#endif
+#ifdef CONFIG_ARM_HYP_VIRQ_ASYNC
+void handleVCPUPostedInterruptsIPI(void);
+#endif
 #endif /* ENABLE_SMP_SUPPORT */
 
 exception_t decodeVCPUWriteReg(cap_t cap, word_t length, word_t *buffer);
@@ -128,12 +170,32 @@ exception_t decodeVCPUReadReg(cap_t cap, word_t length, bool_t call, word_t *buf
 exception_t decodeVCPUInjectIRQ(cap_t cap, word_t length, word_t *buffer);
 exception_t decodeVCPUSetTCB(cap_t cap);
 exception_t decodeVCPUAckVPPI(cap_t cap, word_t length, word_t *buffer);
+#ifdef CONFIG_ARM_HYP_VIRQ_QUEUE
+exception_t decodeVCPUQueueIRQ(cap_t cap, word_t length, word_t *buffer);
+#endif
+#ifdef CONFIG_ARM_HYP_VPPI_INJECT
+exception_t decodeVCPUSetVPPIInjection(cap_t cap, word_t length, word_t *buffer);
+#endif
+#ifdef CONFIG_VCPU_REG_BATCH
+exception_t decodeVCPUReadRegBatch(cap_t cap, word_t length, bool_t call, word_t *buffer);
+exception_t decodeVCPUWriteRegBatch(cap_t cap, word_t length, word_t *buffer);
+#endif
 
 exception_t invokeVCPUWriteReg(vcpu_t *vcpu, word_t field, word_t value);
 exception_t invokeVCPUReadReg(vcpu_t *vcpu, word_t field, bool_t call);
 exception_t invokeVCPUInjectIRQ(vcpu_t *vcpu, unsigned long index, virq_t virq);
 exception_t invokeVCPUSetTCB(vcpu_t *vcpu, tcb_t *tcb);
 exception_t invokeVCPUAckVPPI(vcpu_t *vcpu, VPPIEventIRQ_t vppi);
+#ifdef CONFIG_ARM_HYP_VIRQ_QUEUE
+exception_t invokeVCPUQueueIRQ(vcpu_t *vcpu, virq_t virq);
+#endif
+#ifdef CONFIG_ARM_HYP_VPPI_INJECT
+exception_t invokeVCPUSetVPPIInjection(vcpu_t *vcpu, VPPIEventIRQ_t vppi, virq_t virq);
+#endif
+#ifdef CONFIG_VCPU_REG_BATCH
+exception_t invokeVCPUReadRegBatch(vcpu_t *vcpu, word_t count, word_t *fields, bool_t call);
+exception_t invokeVCPUWriteRegBatch(vcpu_t *vcpu, word_t count, word_t *fields, word_t *values);
+#endif
 static word_t vcpu_hw_read_reg(word_t reg_index);
 static void vcpu_hw_write_reg(word_t reg_index, word_t reg);
 
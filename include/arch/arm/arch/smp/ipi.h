@@ -18,6 +18,9 @@ typedef enum {
     IpiRemoteCall_MaskPrivateInterrupt,
 #ifdef CONFIG_ARM_HYPERVISOR_SUPPORT
     IpiRemoteCall_VCPUInjectInterrupt,
+#endif
+#ifdef CONFIG_ARM_HYP_VIRQ_QUEUE
+    IpiRemoteCall_VCPUQueueInterrupt,
 #endif
     /* Add relevant calls here upon required */
     IpiNumArchRemoteCall
@@ -23,12 +23,21 @@ typedef word_t node_id_t;
 typedef word_t cpu_id_t;
 typedef word_t dom_t;
 
+#ifdef CONFIG_ARM_HYP_VMID_16BIT
+typedef uint16_t hw_asid_t;
+
+enum hwASIDConstants {
+    hwASIDMax = 65535,
+    hwASIDBits = 16
+};
+#else
 typedef uint8_t  hw_asid_t;
 
 enum hwASIDConstants {
     hwASIDMax = 255,
     hwASIDBits = 8
 };
+#endif
 
 typedef struct kernel_frame {
     paddr_t paddr;
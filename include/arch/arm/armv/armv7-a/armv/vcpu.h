@@ -771,7 +771,11 @@ static inline void vcpu_enable(vcpu_t *vcpu)
     access_fpexc(vcpu, true);
 #endif
     /* Restore virtual timer state */
+#ifdef CONFIG_ARM_HYP_VCPU_RESIDENT
+    resume_virt_timer(vcpu);
+#else
     restore_virt_timer(vcpu);
+#endif
 
 }
 
@@ -815,7 +819,11 @@ static inline void vcpu_disable(vcpu_t *vcpu)
     isb();
     if (likely(vcpu)) {
         /* Save virtual timer state */
+#ifdef CONFIG_ARM_HYP_VCPU_RESIDENT
+        pause_virt_timer(vcpu);
+#else
         save_virt_timer(vcpu);
+#endif
         /* Mask the virtual timer interrupt */
         maskInterrupt(true, CORE_IRQ_TO_IRQT(CURRENT_CPU_INDEX(), INTERRUPT_VTIMER_EVENT));
     }
@@ -14,6 +14,9 @@
 #define PMCNTENSET "PMCNTENSET_EL0"
 #define PMINTENSET "PMINTENSET_EL1"
 #define PMOVSR "PMOVSCLR_EL0"
+#define PMSELR "PMSELR_EL0"
+#define PMXEVTYPER "PMXEVTYPER_EL0"
+#define PMXEVCNTR "PMXEVCNTR_EL0"
 #define CCNT_INDEX 31
 
 static inline void armv_enableOverflowIRQ(void)
@@ -63,6 +63,7 @@
 #define VTCR_EL2_SH0(x)     (((x) & 0x3) << 12)
 #define VTCR_EL2_TG0(x)     (((x) & 0x3) << 14)
 #define VTCR_EL2_PS(x)      (((x) & 0x7) << 16)
+#define VTCR_EL2_VS         BIT(19)
 
 /* Physical address size */
 #define PS_4G               0
@@ -79,6 +80,8 @@
 
 #define ID_AA64MMFR0_EL1_PARANGE(x) ((x) & 0xf)
 #define ID_AA64MMFR0_TGRAN4(x)      (((x) >> 28u) & 0xf)
+#define ID_AA64MMFR1_VMIDBITS(x)    (((x) >> 4u) & 0xf)
+#define VMIDBITS_16                 2
 
 /* Shareability attributes */
 #define SH0_NONE            0
@@ -125,6 +128,7 @@
 #define REG_VMPIDR_EL2      "vmpidr_el2"
 #define REG_MPIDR_EL1       "mpidr_el1"
 #define REG_ID_AA64MMFR0_EL1 "id_aa64mmfr0_el1"
+#define REG_ID_AA64MMFR1_EL1 "id_aa64mmfr1_el1"
 
 /* for EL1 SCTLR */
 static inline word_t getSCTLR(void)
@@ -589,6 +593,12 @@ static inline void vcpu_init_vtcr(void)
     if (granule) {
         fail("Processor does not support 4KB");
     }
+#ifdef CONFIG_ARM_HYP_VMID_16BIT
+    MRS(REG_ID_AA64MMFR1_EL1, val);
+    if (ID_AA64MMFR1_VMIDBITS(val) != VMIDBITS_16) {
+        fail("Processor does not support 16-bit VMIDs");
+    }
+#endif
 
     /* Set up the stage-2 translation control register for cores supporting 44-bit PA */
     uint32_t vtcr_el2;
@@ -606,6 +616,9 @@ static inline void vcpu_init_vtcr(void)
     vtcr_el2 |= VTCR_EL2_SH0(SH0_INNER);                     // inner shareable
     vtcr_el2 |= VTCR_EL2_TG0(TG0_4K);                        // 4KiB page size
     vtcr_el2 |= BIT(31);                                     // reserved as 1
+#ifdef CONFIG_ARM_HYP_VMID_16BIT
+    vtcr_el2 |= VTCR_EL2_VS;                                 // 16-bit VMID
+#endif
 
     MSR(REG_VTCR_EL2, vtcr_el2);
     isb();
@@ -660,7 +673,11 @@ static inline void vcpu_enable(vcpu_t *vcpu)
     vcpu_restore_reg(vcpu, seL4_VCPUReg_CPACR);
 #endif
     /* Restore virtual timer state */
+#ifdef CONFIG_ARM_HYP_VCPU_RESIDENT
+    resume_virt_timer(vcpu);
+#else
     restore_virt_timer(vcpu);
+#endif
 }
 
 static inline void vcpu_disable(vcpu_t *vcpu)
@@ -703,7 +720,11 @@ static inline void vcpu_disable(vcpu_t *vcpu)
 #endif
     if (likely(vcpu)) {
         /* Save virtual timer state */
+#ifdef CONFIG_ARM_HYP_VCPU_RESIDENT
+        pause_virt_timer(vcpu);
+#else
         save_virt_timer(vcpu);
+#endif
         /* Mask the virtual timer interrupt */
         maskInterrupt(true, CORE_IRQ_TO_IRQT(CURRENT_CPU_INDEX(), INTERRUPT_VTIMER_EVENT));
     }
@@ -743,7 +764,9 @@ static inline bool_t vcpu_reg_saved_when_disabled(word_t field)
 {
     switch (field) {
     case seL4_VCPUReg_SCTLR:
+#ifndef CONFIG_ARM_HYP_VCPU_RESIDENT
     case seL4_VCPUReg_CNTV_CTL:
+#endif
 #ifdef CONFIG_HAVE_FPU
     case seL4_VCPUReg_CPACR:
 #endif
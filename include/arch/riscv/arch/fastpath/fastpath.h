@@ -36,10 +36,37 @@ NORETURN;
 #define endpoint_ptr_get_epQueue_tail_fp(ep_ptr) TCB_PTR(endpoint_ptr_get_epQueue_tail(ep_ptr))
 #define cap_vtable_cap_get_vspace_root_fp(vtable_cap) PTE_PTR(cap_page_table_cap_get_capPTBasePtr(vtable_cap))
 
+#ifdef CONFIG_RISCV_HW_ASID_ALLOCATOR
+/* The hardware ASID of a VSpace root for the fastpath, or zero if the slowpath
+ * first has to allocate one. Zero is also returned if ASIDs are not in use. */
+static inline word_t FORCE_INLINE getHWASID_fp(asid_t asid, pte_t *vroot)
+{
+    asid_pool_t *poolPtr;
+    pte_t *entry;
+
+    if (riscvKSHWASIDBits == ASID_BITS) {
+        return asid;
+    }
+
+    poolPtr = riscvKSASIDTable[asid >> asidLowBits];
+    if (unlikely(poolPtr == NULL)) {
+        return 0;
+    }
+    entry = poolPtr->array[asid & MASK(asidLowBits)];
+    if (unlikely(asidPoolEntryVSpace(entry) != vroot)) {
+        return 0;
+    }
+    return asidPoolEntryHWASID(entry);
+}
+#endif
+
 static inline void FORCE_INLINE switchToThread_fp(tcb_t *thread, pte_t *vroot, pte_t stored_hw_asid)
 {
     asid_t asid = (asid_t)(stored_hw_asid.words[0]);
 
+#ifdef CONFIG_RISCV_HW_ASID_ALLOCATOR
+    ARCH_NODE_STATE(riscvKSActiveHWASID) = asid;
+#endif
     setVSpaceRoot(addrFromPPtr(vroot), asid);
 
     NODE_STATE(ksCurThread) = thread;
@@ -157,6 +157,15 @@ static inline void write_satp(word_t value)
     asm volatile("csrw satp, %0" :: "rK"(value));
 }
 
+#ifdef CONFIG_RISCV_HW_ASID_ALLOCATOR
+static inline word_t read_satp(void)
+{
+    word_t temp;
+    asm volatile("csrr %0, satp" : "=r"(temp));
+    return temp;
+}
+#endif
+
 static inline void write_stvec(word_t value)
 {
     asm volatile("csrw stvec, %0" :: "rK"(value));
@@ -259,6 +268,14 @@ static inline void setVSpaceRoot(paddr_t addr, asid_t asid)
 
     write_satp(satp.words[0]);
 
+#ifdef CONFIG_RISCV_HW_ASID_ALLOCATOR
+    /* Hardware ASIDs are only handed out again once their translations have
+     * been flushed, so no fence is needed unless ASIDs are not in use. */
+    if (riscvKSHWASIDBits != 0) {
+        return;
+    }
+#endif
+
     /* Order read/write operations */
 #ifdef ENABLE_SMP_SUPPORT
     sfence_local();
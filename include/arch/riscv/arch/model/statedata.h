@@ -20,10 +20,20 @@ NODE_STATE_BEGIN(archNodeState)
 /* TODO: add RISCV-dependent fields here */
 /* Bitmask of all cores should receive the reschedule IPI */
 NODE_STATE_DECLARE(word_t, ipiReschedulePending);
+#ifdef CONFIG_RISCV_HW_ASID_ALLOCATOR
+/* Hardware ASID last loaded into satp on this core */
+NODE_STATE_DECLARE(word_t, riscvKSActiveHWASID);
+#endif
 NODE_STATE_END(archNodeState);
 
 extern asid_pool_t *riscvKSASIDTable[BIT(asidHighBits)];
 
+#ifdef CONFIG_RISCV_HW_ASID_ALLOCATOR
+extern word_t riscvKSHWASIDBits;
+extern word_t riscvKSNextHWASID;
+extern word_t riscvKSReservedHWASIDs[CONFIG_MAX_NUM_NODES];
+#endif
+
 /* Kernel Page Tables */
 extern pte_t kernel_root_pageTable[BIT(PT_INDEX_BITS)] VISIBLE;
 
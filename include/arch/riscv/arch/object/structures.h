@@ -33,6 +33,24 @@ typedef struct asid_pool asid_pool_t;
 #define ASID_LOW(a)         (a & MASK(asidLowBits))
 #define ASID_HIGH(a)        ((a >> asidLowBits) & MASK(asidHighBits))
 
+#ifdef CONFIG_RISCV_HW_ASID_ALLOCATOR
+/* When hardware ASIDs are narrower than seL4 ASIDs, the hardware ASID assigned
+ * to an address space is kept in the low bits of its ASID pool entry. These are
+ * otherwise zero since root page tables are page aligned. Hardware ASID 0 is
+ * used by the kernel's own address space and marks an entry without one. */
+#define HW_ASID_TAG_BITS    seL4_PageTableBits
+
+static inline pte_t *asidPoolEntryVSpace(pte_t *entry)
+{
+    return (pte_t *)((word_t)entry & ~MASK(HW_ASID_TAG_BITS));
+}
+
+static inline word_t asidPoolEntryHWASID(pte_t *entry)
+{
+    return (word_t)entry & MASK(HW_ASID_TAG_BITS);
+}
+#endif
+
 typedef struct arch_tcb {
     user_context_t tcbContext;
 } arch_tcb_t;
@@ -38,3 +38,34 @@ static inline void invalidateASID(vspace_root_t *vspace, asid_t asid, word_t mas
     SMP_COND_STATEMENT(doRemoteInvalidateASID(vspace, asid, mask));
 }
 
+#ifdef CONFIG_X86_RANGE_TLB_INVALIDATION
+/*
+ * Virtual addresses of the mappings below a paging structure that is being
+ * removed. tables counts the page tables scanned to collect them.
+ */
+typedef struct tlb_flush_list {
+    word_t count;
+    word_t tables;
+    vptr_t vaddrs[CONFIG_X86_RANGE_TLB_INVALIDATION_MAX_PAGES];
+} tlb_flush_list_t;
+
+/* The list lives on the kernel stack of the unmapping thread */
+compile_assert(tlb_flush_list_fits_kernel_stack,
+               sizeof(tlb_flush_list_t) <= BIT(CONFIG_KERNEL_STACK_BITS) / 8)
+
+static inline void invalidateLocalTranslationList(tlb_flush_list_t *list, asid_t asid)
+{
+    word_t i;
+
+    for (i = 0; i < list->count; i++) {
+        invalidateLocalPCID(INVPCID_TYPE_ADDR, (void *)list->vaddrs[i], asid);
+    }
+}
+
+static inline void invalidateTranslationList(tlb_flush_list_t *list, asid_t asid, word_t mask)
+{
+    invalidateLocalTranslationList(list, asid);
+    SMP_COND_STATEMENT(doRemoteInvalidateTranslationList(list, asid, mask));
+}
+#endif /* CONFIG_X86_RANGE_TLB_INVALIDATION */
+
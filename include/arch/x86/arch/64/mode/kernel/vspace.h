@@ -62,3 +62,7 @@ static inline CONST pml4e_t x86_make_empty_root_mapping(void)
            );
 }
 
+#ifdef CONFIG_X86_RANGE_TLB_INVALIDATION
+struct tlb_flush_list;
+bool_t collectTableMappings(struct tlb_flush_list *list, pte_t *pt, vptr_t vptr);
+#endif
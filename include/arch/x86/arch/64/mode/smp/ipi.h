@@ -16,6 +16,9 @@
 typedef enum {
     IpiRemoteCall_InvalidatePCID = IpiNumArchRemoteCall,
     IpiRemoteCall_InvalidateASID,
+#ifdef CONFIG_X86_RANGE_TLB_INVALIDATION
+    IpiRemoteCall_InvalidateTranslationList,
+#endif
     IpiNumModeRemoteCall
 } IpiModeRemoteCall_t;
 
@@ -31,5 +34,15 @@ static inline void doRemoteInvalidateASID(vspace_root_t *vspace, asid_t asid, wo
     doRemoteMaskOp2Arg((IpiRemoteCall_t)IpiRemoteCall_InvalidateASID, (word_t)vspace, asid, mask);
 }
 
+#ifdef CONFIG_X86_RANGE_TLB_INVALIDATION
+struct tlb_flush_list;
+
+/* The remote call is synchronous, so the list may live on the caller's stack */
+static inline void doRemoteInvalidateTranslationList(struct tlb_flush_list *list, asid_t asid, word_t mask)
+{
+    doRemoteMaskOp2Arg((IpiRemoteCall_t)IpiRemoteCall_InvalidateTranslationList, (word_t)list, asid, mask);
+}
+#endif
+
 #endif /* ENABLE_SMP_SUPPORT */
 
@@ -35,5 +35,10 @@ static inline void benchmark_arch_utilisation_reset(void)
 {
 }
 
+#ifdef CONFIG_BENCHMARK_SAMPLE_PROFILE
+bool_t x86_init_pmu_sampling(void);
+void x86_handle_sample_overflow(void);
+#endif /* CONFIG_BENCHMARK_SAMPLE_PROFILE */
+
 #endif /* CONFIG_ENABLE_BENCHMARKS */
 
@@ -32,6 +32,10 @@
 #define IA32_XSS_MSR            0xD0A
 #define IA32_FEATURE_CONTROL_MSR 0x3A
 #define IA32_KERNEL_GS_BASE_MSR 0xC0000102
+#define IA32_PMC0_MSR           0xC1
+#define IA32_PERFEVTSEL0_MSR    0x186
+#define IA32_PERF_GLOBAL_CTRL_MSR 0x38F
+#define IA32_PERF_GLOBAL_OVF_CTRL_MSR 0x390
 #define IA32_VMX_BASIC_MSR      0x480
 #define IA32_VMX_PINBASED_CTLS_MSR 0x481
 #define IA32_VMX_PROCBASED_CTLS_MSR 0x482
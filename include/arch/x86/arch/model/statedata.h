@@ -76,6 +76,14 @@ extern vtd_rte_t *x86KSvtdRootTable;
 extern uint32_t x86KSnumIOPTLevels;
 extern uint32_t x86KSnumIODomainIDBits;
 extern uint32_t x86KSFirstValidIODomain;
+#ifdef CONFIG_IOMMU_QUEUED_INVALIDATION
+extern bool_t x86KSvtdQueuedInvalidation;
+extern bool_t x86KSvtdPageSelectiveInvalidation;
+extern uint64_t *x86KSvtdInvQueue;
+extern uint32_t *x86KSvtdInvStatus;
+extern word_t x86KSvtdInvQueueHead;
+extern word_t x86KSvtdInvQueueTail;
+#endif
 #endif
 
 #ifdef CONFIG_PRINTING
@@ -36,7 +36,7 @@ typedef struct lookupIOPTSlot_ret lookupIOPTSlot_ret_t;
 cap_t master_iospace_cap(void);
 exception_t decodeX86IOPTInvocation(word_t invLabel, word_t length, cte_t *slot, cap_t cap, word_t  *buffer);
 exception_t decodeX86IOMapInvocation(word_t length, cte_t *slot, cap_t cap, word_t *buffer);
-exception_t decodeX86IOSpaceInvocation(word_t invLabel, cap_t cap);
+exception_t decodeX86IOSpaceInvocation(word_t invLabel, word_t length, cap_t cap, word_t *buffer);
 exception_t performX86IOUnMapInvocation(cap_t cap, cte_t *ctSlot);
 void unmapIOPage(cap_t cap);
 void deleteIOPageTable(cap_t cap);
@@ -13,6 +13,7 @@
 #include <arch/machine/hardware.h>
 #include <sel4/benchmark_tracepoints_types.h>
 #include <mode/hardware.h>
+#include <model/statedata.h>
 
 #ifdef CONFIG_ENABLE_BENCHMARKS
 exception_t handle_SysBenchmarkFlushCaches(void);
@@ -24,11 +25,23 @@ exception_t handle_SysBenchmarkSetLogBuffer(void);
 #ifdef CONFIG_BENCHMARK_TRACK_UTILISATION
 exception_t handle_SysBenchmarkGetThreadUtilisation(void);
 exception_t handle_SysBenchmarkResetThreadUtilisation(void);
+exception_t handle_SysBenchmarkGetDomainUtilisation(void);
+#ifdef CONFIG_KERNEL_MCS
+exception_t handle_SysBenchmarkGetSchedContextUtilisation(void);
+#endif
 #ifdef CONFIG_DEBUG_BUILD
 exception_t handle_SysBenchmarkDumpAllThreadsUtilisation(void);
 exception_t handle_SysBenchmarkResetAllThreadsUtilisation(void);
 #endif /* CONFIG_DEBUG_BUILD */
 #endif /* CONFIG_BENCHMARK_TRACK_UTILISATION */
+#ifdef CONFIG_BENCHMARK_FASTPATH_COUNTERS
+exception_t handle_SysBenchmarkGetFastpathCounters(void);
+exception_t handle_SysBenchmarkResetFastpathCounters(void);
+#endif /* CONFIG_BENCHMARK_FASTPATH_COUNTERS */
+#ifdef CONFIG_BENCHMARK_PREEMPTION_LATENCY
+exception_t handle_SysBenchmarkGetPreemptionCounters(void);
+exception_t handle_SysBenchmarkResetPreemptionCounters(void);
+#endif /* CONFIG_BENCHMARK_PREEMPTION_LATENCY */
 #endif /* CONFIG_ENABLE_BENCHMARKS */
 
 #if CONFIG_MAX_NUM_TRACE_POINTS > 0
@@ -40,8 +53,6 @@ exception_t handle_SysBenchmarkResetAllThreadsUtilisation(void);
 extern timestamp_t ksEntries[CONFIG_MAX_NUM_TRACE_POINTS];
 extern bool_t ksStarted[CONFIG_MAX_NUM_TRACE_POINTS];
 extern timestamp_t ksExit;
-extern seL4_Word ksLogIndex;
-extern seL4_Word ksLogIndexFinalized;
 extern paddr_t ksUserLogBuffer;
 
 static inline void trace_point_start(word_t id)
@@ -0,0 +1,45 @@
+/*
+ * Copyright 2026, seL4 Project a Series of LF Projects, LLC
+ *
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#pragma once
+
+#include <config.h>
+
+#ifdef CONFIG_BENCHMARK_FASTPATH_COUNTERS
+#include <types.h>
+#include <util.h>
+#include <arch/api/syscall.h>
+#include <model/statedata.h>
+#include <sel4/benchmark_fastpath_types.h>
+
+static inline word_t benchmark_fastpath_path(syscall_t syscall)
+{
+    switch (syscall) {
+    case SysCall:
+        return BENCHMARK_FASTPATH_CALL;
+    case SysReplyRecv:
+        return BENCHMARK_FASTPATH_REPLY_RECV;
+    default:
+        return BENCHMARK_FASTPATH_SIGNAL;
+    }
+}
+
+static inline void benchmark_fastpath_count(syscall_t syscall, word_t counter)
+{
+    NODE_STATE(ksFastpathCounters)[benchmark_fastpath_path(syscall)][counter]++;
+}
+
+static inline void benchmark_fastpath_reset(void)
+{
+    for (word_t i = 0; i < CONFIG_MAX_NUM_NODES; i++) {
+        memzero(NODE_STATE_ON_CORE(ksFastpathCounters, i), sizeof(NODE_STATE(ksFastpathCounters)));
+    }
+}
+
+#define FASTPATH_COUNT(syscall, counter) benchmark_fastpath_count(syscall, counter)
+#else
+#define FASTPATH_COUNT(syscall, counter)
+#endif /* CONFIG_BENCHMARK_FASTPATH_COUNTERS */
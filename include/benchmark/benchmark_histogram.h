@@ -0,0 +1,25 @@
+/*
+ * Copyright 2026, seL4 Project a Series of LF Projects, LLC
+ *
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#pragma once
+
+#include <config.h>
+#include <types.h>
+#include <util.h>
+#include <sel4/benchmark_histogram_types.h>
+
+/* Index of the log-linear histogram bucket that counts duration */
+static inline word_t benchmark_histogram_bucket(uint32_t duration)
+{
+    word_t msb;
+
+    if (duration < BIT(seL4_LogHistogramSubBucketBits)) {
+        return duration;
+    }
+    msb = wordBits - 1 - clzl(duration);
+    return ((msb - seL4_LogHistogramSubBucketBits + 1) << seL4_LogHistogramSubBucketBits) |
+           ((duration >> (msb - seL4_LogHistogramSubBucketBits)) & MASK(seL4_LogHistogramSubBucketBits));
+}
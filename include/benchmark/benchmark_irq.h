@@ -0,0 +1,71 @@
+/*
+ * Copyright 2026, seL4 Project a Series of LF Projects, LLC
+ *
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#pragma once
+
+#include <config.h>
+
+#ifdef CONFIG_BENCHMARK_IRQ_LATENCY
+#include <types.h>
+#include <arch/benchmark.h>
+#include <sel4/benchmark_irq_types.h>
+#include <sel4/arch/constants.h>
+#include <mode/hardware.h>
+#include <model/statedata.h>
+
+static inline benchmark_irq_latency_table_t *benchmark_irq_latency_table(word_t core)
+{
+    return (benchmark_irq_latency_table_t *)(KS_LOG_PPTR + core * seL4_LogIRQLatencyTableSize);
+}
+
+/* Called on every kernel entry */
+static inline void benchmark_irq_latency_enter(void)
+{
+    NODE_STATE(ksIRQLatency).kernel_enter = timestamp();
+}
+
+/**
+ * @brief Clear the IRQ latency tables of all cores
+ *
+ * The log buffer must be mapped.
+ */
+void benchmark_irq_latency_reset(void);
+
+/**
+ * @brief Number of IRQ latency records in use on all cores
+ *
+ */
+word_t benchmark_irq_latency_count(void);
+
+/**
+ * @brief Start tracing an interrupt that handleInterrupt is about to handle
+ *
+ * An interrupt still traced on this core is completed without the stages it
+ * has not reached.
+ */
+void benchmark_irq_latency_dispatch(word_t irq);
+
+/**
+ * @brief Record that the interrupt traced on this core signalled its notification
+ *
+ */
+void benchmark_irq_latency_signal(void);
+
+/**
+ * @brief Record the thread woken by sendSignal
+ *
+ * Only has an effect while the signal of a traced interrupt is being sent.
+ */
+void benchmark_irq_latency_wake(tcb_t *tcb);
+
+/**
+ * @brief Called on every kernel exit
+ *
+ * Completes the interrupt traced on this core, unless the thread it woke has
+ * not run yet.
+ */
+void benchmark_irq_latency_exit(void);
+#endif /* CONFIG_BENCHMARK_IRQ_LATENCY */
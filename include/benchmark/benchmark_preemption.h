@@ -0,0 +1,92 @@
+/*
+ * Copyright 2026, seL4 Project a Series of LF Projects, LLC
+ *
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#pragma once
+
+#include <config.h>
+
+#ifdef CONFIG_BENCHMARK_PREEMPTION_LATENCY
+#include <types.h>
+#include <util.h>
+#include <arch/benchmark.h>
+#include <model/statedata.h>
+#include <sel4/benchmark_preemption_types.h>
+
+static inline void benchmark_preemption_interval(word_t counter, timestamp_t *since, timestamp_t now)
+{
+    uint64_t *max = &NODE_STATE(ksPreemptionCounters)[NODE_STATE(ksPreemptionOp)][counter];
+
+    if (now - *since > *max) {
+        *max = now - *since;
+    }
+    *since = now;
+}
+
+/* Mark the start of the long-running operation op and return the operation
+ * it interrupts, which the caller restores once op is done. The stretch still
+ * open is charged to the operation that ran it. */
+static inline word_t benchmark_preemption_op(word_t op)
+{
+    word_t prev = NODE_STATE(ksPreemptionOp);
+
+    if (op != prev) {
+        timestamp_t now = timestamp();
+
+        benchmark_preemption_interval(BENCHMARK_PREEMPTION_MAX_POINT_INTERVAL, &NODE_STATE(ksPreemptionLastPoint), now);
+        benchmark_preemption_interval(BENCHMARK_PREEMPTION_MAX_CHECK_INTERVAL, &NODE_STATE(ksPreemptionLastCheck), now);
+        NODE_STATE(ksPreemptionOp) = op;
+    }
+    return prev;
+}
+
+/* Called on every kernel entry */
+static inline void benchmark_preemption_enter(void)
+{
+    timestamp_t now = timestamp();
+
+    NODE_STATE(ksPreemptionOp) = BENCHMARK_PREEMPTION_OP_NONE;
+    NODE_STATE(ksPreemptionLastPoint) = now;
+    NODE_STATE(ksPreemptionLastCheck) = now;
+}
+
+/* Called on every kernel exit */
+static inline void benchmark_preemption_exit(void)
+{
+    timestamp_t now = timestamp();
+
+    benchmark_preemption_interval(BENCHMARK_PREEMPTION_MAX_POINT_INTERVAL, &NODE_STATE(ksPreemptionLastPoint), now);
+    benchmark_preemption_interval(BENCHMARK_PREEMPTION_MAX_CHECK_INTERVAL, &NODE_STATE(ksPreemptionLastCheck), now);
+}
+
+/* Called by preemptionPoint */
+static inline void benchmark_preemption_point(void)
+{
+    NODE_STATE(ksPreemptionCounters)[NODE_STATE(ksPreemptionOp)][BENCHMARK_PREEMPTION_POINTS]++;
+    benchmark_preemption_interval(BENCHMARK_PREEMPTION_MAX_POINT_INTERVAL, &NODE_STATE(ksPreemptionLastPoint),
+                                  timestamp());
+}
+
+/* Called by preemptionPoint before it checks for pending interrupts */
+static inline void benchmark_preemption_irq_check(void)
+{
+    NODE_STATE(ksPreemptionCounters)[NODE_STATE(ksPreemptionOp)][BENCHMARK_PREEMPTION_IRQ_CHECKS]++;
+    benchmark_preemption_interval(BENCHMARK_PREEMPTION_MAX_CHECK_INTERVAL, &NODE_STATE(ksPreemptionLastCheck),
+                                  timestamp());
+}
+
+/* Called by preemptionPoint when it preempts the operation */
+static inline void benchmark_preemption_preempted(void)
+{
+    NODE_STATE(ksPreemptionCounters)[NODE_STATE(ksPreemptionOp)][BENCHMARK_PREEMPTION_PREEMPTED]++;
+}
+
+static inline void benchmark_preemption_reset(void)
+{
+    for (word_t i = 0; i < CONFIG_MAX_NUM_NODES; i++) {
+        memzero(NODE_STATE_ON_CORE(ksPreemptionCounters, i), sizeof(NODE_STATE(ksPreemptionCounters)));
+    }
+}
+#endif /* CONFIG_BENCHMARK_PREEMPTION_LATENCY */
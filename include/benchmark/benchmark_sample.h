@@ -0,0 +1,58 @@
+/*
+ * Copyright 2026, seL4 Project a Series of LF Projects, LLC
+ *
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#pragma once
+
+#include <config.h>
+
+#ifdef CONFIG_BENCHMARK_SAMPLE_PROFILE
+#include <types.h>
+#include <arch/benchmark.h>
+#include <sel4/benchmark_sample_types.h>
+#include <sel4/arch/constants.h>
+#include <mode/hardware.h>
+#include <object/structures.h>
+#include <model/statedata.h>
+
+/* Samples are only recorded between seL4_BenchmarkResetLog and
+ * seL4_BenchmarkFinalizeLog */
+extern bool_t ksSampleProfileEnabled;
+
+static inline benchmark_sample_log_t *benchmark_sample_log(word_t core)
+{
+    return (benchmark_sample_log_t *)(KS_LOG_PPTR + core * seL4_LogSampleLogSize);
+}
+
+/**
+ * @brief Empty the sample logs of all cores
+ *
+ * The log buffer must be mapped.
+ */
+void benchmark_sample_reset(void);
+
+/**
+ * @brief Number of samples written to all logs since the last reset
+ *
+ */
+word_t benchmark_sample_count(void);
+
+/**
+ * @brief Record a sample of the current thread on the current core
+ *
+ * Called by the architecture's PMU overflow interrupt handler.
+ */
+void benchmark_sample_record(void);
+
+#if CONFIG_BENCHMARK_SAMPLE_PROFILE_USER_FRAMES > 0
+/**
+ * @brief Fill frames with the return addresses of the user-level stack frames
+ *        of thread, following its frame pointer chain
+ *
+ * Implemented by the architecture. Unused frames are left untouched.
+ */
+void benchmark_arch_sample_user_frames(tcb_t *thread, word_t *frames);
+#endif
+#endif /* CONFIG_BENCHMARK_SAMPLE_PROFILE */
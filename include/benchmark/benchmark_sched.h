@@ -0,0 +1,73 @@
+/*
+ * Copyright 2026, seL4 Project a Series of LF Projects, LLC
+ *
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#pragma once
+
+#include <config.h>
+
+#ifdef CONFIG_BENCHMARK_SCHED_TRACE
+#include <types.h>
+#include <arch/benchmark.h>
+#include <sel4/benchmark_sched_types.h>
+#include <sel4/arch/constants.h>
+#include <mode/hardware.h>
+#include <object/structures.h>
+#include <model/statedata.h>
+
+/* Events are only recorded between seL4_BenchmarkResetLog and
+ * seL4_BenchmarkFinalizeLog */
+extern bool_t ksSchedTraceEnabled;
+
+static inline benchmark_sched_log_t *benchmark_sched_log(word_t core)
+{
+    return (benchmark_sched_log_t *)(KS_LOG_PPTR + core * seL4_LogSchedLogSize);
+}
+
+/**
+ * @brief Empty the event logs of all cores
+ *
+ * The log buffer must be mapped.
+ */
+void benchmark_sched_reset(void);
+
+/**
+ * @brief Number of events written to all logs since the last reset
+ *
+ */
+word_t benchmark_sched_count(void);
+
+/**
+ * @brief Append an event to the log of the current core
+ *
+ * @param type A benchmark_sched_event_type.
+ * @param tcb  The thread the event is about, or NULL.
+ * @param arg  Depends on type.
+ */
+void benchmark_sched_record(word_t type, tcb_t *tcb, uint64_t arg);
+
+/**
+ * @brief Record a wake or block event if the thread state change to ts
+ *        changes whether tcb is runnable
+ *
+ * Called by setThreadState before tcb's state is changed.
+ */
+void benchmark_sched_state(tcb_t *tcb, word_t ts);
+
+/**
+ * @brief Record a switch from the current thread to thread done by a fastpath
+ *
+ * The fastpaths change thread states and switch threads without going through
+ * setThreadState and switchToThread. Called once the new state of the current
+ * thread has been set.
+ */
+void benchmark_sched_fastpath_switch(tcb_t *thread);
+
+#define FASTPATH_SCHED_SWITCH(thread) benchmark_sched_fastpath_switch(thread)
+#define FASTPATH_SCHED_WAKE(thread) benchmark_sched_record(BENCHMARK_SCHED_WAKE, thread, ThreadState_Running)
+#else
+#define FASTPATH_SCHED_SWITCH(thread)
+#define FASTPATH_SCHED_WAKE(thread)
+#endif /* CONFIG_BENCHMARK_SCHED_TRACE */
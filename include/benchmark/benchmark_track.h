@@ -28,8 +28,6 @@ extern kernel_entry_t ksKernelEntry;
              sizeof(benchmark_track_kernel_entry_t))
 
 extern timestamp_t ksEnter;
-extern seL4_Word ksLogIndex;
-extern seL4_Word ksLogIndexFinalized;
 
 /**
  * @brief Fill in logging info for kernel entries
@@ -37,6 +35,46 @@ extern seL4_Word ksLogIndexFinalized;
  */
 void benchmark_track_exit(void);
 
+#ifdef CONFIG_BENCHMARK_TRACK_KERNEL_ENTRIES_RING
+static inline benchmark_track_ring_t *benchmark_track_ring(word_t core)
+{
+    return (benchmark_track_ring_t *)(KS_LOG_PPTR + core * seL4_LogRingSize);
+}
+
+/**
+ * @brief Empty the kernel entry rings of all cores
+ *
+ * The log buffer must be mapped.
+ */
+void benchmark_track_ring_reset(void);
+
+/**
+ * @brief Number of kernel entries written to all rings since the last reset
+ *
+ */
+word_t benchmark_track_ring_count(void);
+#endif /* CONFIG_BENCHMARK_TRACK_KERNEL_ENTRIES_RING */
+
+#ifdef CONFIG_BENCHMARK_TRACK_KERNEL_ENTRIES_HISTOGRAM
+static inline benchmark_track_histogram_table_t *benchmark_track_histogram_table(word_t core)
+{
+    return (benchmark_track_histogram_table_t *)(KS_LOG_PPTR + core * seL4_LogHistogramTableSize);
+}
+
+/**
+ * @brief Clear the histogram tables of all cores
+ *
+ * The log buffer must be mapped.
+ */
+void benchmark_track_histogram_reset(void);
+
+/**
+ * @brief Number of histograms in use on all cores
+ *
+ */
+word_t benchmark_track_histogram_count(void);
+#endif /* CONFIG_BENCHMARK_TRACK_KERNEL_ENTRIES_HISTOGRAM */
+
 /**
  * @brief Start logging kernel entries
  *
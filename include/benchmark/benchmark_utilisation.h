@@ -18,6 +18,28 @@ extern timestamp_t ksEnter;
 void benchmark_track_utilisation_dump(void);
 
 void benchmark_track_reset_utilisation(tcb_t *tcb);
+
+/* Zero the domain and scheduling context counters of the current core */
+void benchmark_track_reset_sched_utilisation(void);
+
+/* Credit the time since the last kernel exit to the current domain and
+ * scheduling context. Called on kernel entry. */
+void benchmark_utilisation_sched_enter(void);
+
+/* Credit the time since kernel entry to the current domain and scheduling
+ * context, which belong to the thread about to run. Called on kernel exit. */
+void benchmark_utilisation_sched_exit(timestamp_t exit);
+
+#ifdef CONFIG_KERNEL_MCS
+/* Count ticks charged to the budget of the current scheduling context */
+void benchmark_utilisation_consumed(ticks_t consumed);
+
+/* @return the counters of sc on core, or NULL if the core has none */
+uint64_t *benchmark_sc_utilisation_find(word_t core, sched_context_t *sc);
+
+/* Drop the counters of sc on all cores, called when sc is deleted */
+void benchmark_sc_utilisation_remove(sched_context_t *sc);
+#endif
 /* Calculate and add the utilisation time from when the heir started to run i.e. scheduled
  * and until it's being kicked off
  */
@@ -46,6 +68,34 @@ static inline void benchmark_utilisation_switch(tcb_t *heir, tcb_t *next)
     }
 }
 
+#ifdef CONFIG_BENCHMARK_TRACK_UTILISATION_PMU
+/* Credit the events counted since the last kernel exit to the user time of the
+ * thread that was running, and remember the counters at kernel entry. */
+static inline void benchmark_utilisation_pmu_enter(void)
+{
+    for (word_t i = 0; i < BENCHMARK_PMU_NUM_EVENTS; i++) {
+        uint32_t count = benchmark_arch_pmu_read(i);
+        if (likely(NODE_STATE(benchmark_log_utilisation_enabled))) {
+            TCB_PTR_PMU_PTR(NODE_STATE(ksCurThread))->pmu_user[i] += (uint32_t)(count - NODE_STATE(benchmark_pmu_exit)[i]);
+        }
+        NODE_STATE(benchmark_pmu_enter)[i] = count;
+    }
+}
+
+/* Credit the events counted since kernel entry to the kernel time of the thread
+ * about to run, and remember the counters at kernel exit. */
+static inline void benchmark_utilisation_pmu_exit(void)
+{
+    for (word_t i = 0; i < BENCHMARK_PMU_NUM_EVENTS; i++) {
+        uint32_t count = benchmark_arch_pmu_read(i);
+        if (likely(NODE_STATE(benchmark_log_utilisation_enabled))) {
+            TCB_PTR_PMU_PTR(NODE_STATE(ksCurThread))->pmu_kernel[i] += (uint32_t)(count - NODE_STATE(benchmark_pmu_enter)[i]);
+        }
+        NODE_STATE(benchmark_pmu_exit)[i] = count;
+    }
+}
+#endif /* CONFIG_BENCHMARK_TRACK_UTILISATION_PMU */
+
 /* Add the time between the last thread got scheduled and when to stop
  * benchmarks
  */
@@ -8,6 +8,7 @@
 
 #include <config.h>
 #include <basic_types.h>
+#include <sel4/benchmark_utilisation_types.h>
 
 #ifdef CONFIG_BENCHMARK_TRACK_UTILISATION
 typedef struct {
@@ -18,5 +19,23 @@ typedef struct {
     uint64_t    number_kernel_entries;
 
 } benchmark_util_t;
+
+#ifdef CONFIG_KERNEL_MCS
+/* Counters of one scheduling context, kept in a per-core table as scheduling
+ * context objects have no space for them. Unused entries have a NULL sc. */
+typedef struct {
+    struct sched_context *sc;
+    uint64_t    counters[BENCHMARK_SC_NUM_COUNTERS];
+} benchmark_sc_util_t;
+#endif /* CONFIG_KERNEL_MCS */
+
+#ifdef CONFIG_BENCHMARK_TRACK_UTILISATION_PMU
+/* Per-thread PMU event counts, split by user and kernel execution. These live
+ * in the 'unused' region of the TCB object rather than in tcb_t. */
+typedef struct {
+    uint64_t    pmu_user[BENCHMARK_PMU_NUM_EVENTS];
+    uint64_t    pmu_kernel[BENCHMARK_PMU_NUM_EVENTS];
+} benchmark_pmu_util_t;
+#endif /* CONFIG_BENCHMARK_TRACK_UTILISATION_PMU */
 #endif /* CONFIG_BENCHMARK_TRACK_UTILISATION */
 
@@ -429,6 +429,10 @@ void plat_smmu_init(void);
 void smmu_tlb_invalidate_all(void);
 void smmu_tlb_invalidate_cb(int cb, asid_t asid);
 void smmu_tlb_invalidate_cb_va(int cb, asid_t asid, vptr_t vaddr);
+void smmu_tlb_invalidate_cb_range(int cb, asid_t asid, vptr_t vaddr, word_t npages, word_t pageBits);
+#ifdef CONFIG_ARM_SMMU_DEFER_TLB_SYNC
+void smmu_tlb_sync_deferred(void);
+#endif
 void smmu_cb_disable(word_t cb, asid_t asid);
 void smmu_sid_unbind(word_t sid);
 void smmu_read_fault_state(uint32_t *status, uint32_t *syndrome_0, uint32_t *syndrome_1);
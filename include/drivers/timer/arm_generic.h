@@ -56,5 +56,11 @@ BOOT_CODE void initGenericTimer(void);
 static uint64_t read_cntpct(void) UNUSED;
 static void save_virt_timer(vcpu_t *vcpu);
 static void restore_virt_timer(vcpu_t *vcpu);
+#ifdef CONFIG_ARM_HYP_VCPU_RESIDENT
+static void pause_virt_timer(vcpu_t *vcpu);
+static void resume_virt_timer(vcpu_t *vcpu);
+static void evict_virt_timer(vcpu_t *vcpu);
+static void load_virt_timer(vcpu_t *vcpu);
+#endif
 #endif /* CONFIG_ARM_HYPERVISOR_SUPPORT */
 
@@ -193,3 +193,12 @@ static inline reply_t *thread_state_get_replyObject_np(thread_state_t ts)
 
 #include <arch/fastpath/fastpath.h>
 
+#include <benchmark/benchmark_fastpath.h>
+#include <benchmark/benchmark_sched.h>
+
+/* Leave the fastpath for the slowpath of syscall, counting the failed check
+ * when fastpath counters are enabled */
+#define fastpath_miss(syscall, reason) do { \
+    FASTPATH_COUNT(syscall, BENCHMARK_FASTPATH_MISS_##reason); \
+    slowpath(syscall); \
+} while (0)
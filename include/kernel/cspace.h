@@ -43,6 +43,14 @@ struct resolveAddressBits_ret {
 };
 typedef struct resolveAddressBits_ret resolveAddressBits_ret_t;
 
+#ifdef CONFIG_FRAME_MAP_RANGE
+struct lookupSlotWindow_ret {
+    exception_t status;
+    cte_t *window;
+};
+typedef struct lookupSlotWindow_ret lookupSlotWindow_ret_t;
+#endif
+
 lookupCap_ret_t lookupCap(tcb_t *thread, cptr_t cPtr);
 lookupCapAndSlot_ret_t lookupCapAndSlot(tcb_t *thread, cptr_t cPtr);
 lookupSlot_raw_ret_t lookupSlot(tcb_t *thread, cptr_t capptr);
@@ -58,4 +66,9 @@ lookupSlot_ret_t lookupPivotSlot(cap_t root, cptr_t capptr,
 resolveAddressBits_ret_t resolveAddressBits(cap_t nodeCap,
                                             cptr_t capptr,
                                             word_t n_bits);
+#ifdef CONFIG_FRAME_MAP_RANGE
+lookupSlotWindow_ret_t lookupSourceWindow(cap_t root, cptr_t nodeIndex,
+                                          word_t nodeDepth, word_t nodeOffset,
+                                          word_t nodeWindow, word_t maxWindow);
+#endif
 
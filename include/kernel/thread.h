@@ -10,6 +10,9 @@
 #include <util.h>
 #include <object/structures.h>
 #include <arch/machine.h>
+#ifdef CONFIG_BENCHMARK_TRACK_UTILISATION
+#include <benchmark/benchmark_utilisation.h>
+#endif
 #ifdef CONFIG_KERNEL_MCS
 #include <kernel/sporadic.h>
 #include <machine/timer.h>
@@ -144,6 +147,9 @@ static inline void commitTime(void)
             assert(refill_ready(NODE_STATE(ksCurSC)));
         }
         NODE_STATE(ksCurSC)->scConsumed += NODE_STATE(ksConsumed);
+#ifdef CONFIG_BENCHMARK_TRACK_UTILISATION
+        benchmark_utilisation_consumed(NODE_STATE(ksConsumed));
+#endif
     }
 
     NODE_STATE(ksConsumed) = 0llu;
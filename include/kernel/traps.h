@@ -10,6 +10,8 @@
 #include <util.h>
 #include <arch/kernel/traps.h>
 #include <smp/lock.h>
+#include <benchmark/benchmark_irq.h>
+#include <benchmark/benchmark_preemption.h>
 
 /* This C function should be the first thing called from C after entry from
  * assembly. It provides a single place to do any entry work that is not
@@ -20,6 +22,18 @@ static inline void c_entry_hook(void)
 #if defined(CONFIG_BENCHMARK_TRACK_KERNEL_ENTRIES) || defined(CONFIG_BENCHMARK_TRACK_UTILISATION)
     ksEnter = timestamp();
 #endif
+#ifdef CONFIG_BENCHMARK_TRACK_UTILISATION
+    benchmark_utilisation_sched_enter();
+#endif
+#ifdef CONFIG_BENCHMARK_TRACK_UTILISATION_PMU
+    benchmark_utilisation_pmu_enter();
+#endif
+#ifdef CONFIG_BENCHMARK_IRQ_LATENCY
+    benchmark_irq_latency_enter();
+#endif
+#ifdef CONFIG_BENCHMARK_PREEMPTION_LATENCY
+    benchmark_preemption_enter();
+#endif
 }
 
 /* This C function should be the last thing called from C before exiting
@@ -38,8 +52,18 @@ static inline void c_exit_hook(void)
         NODE_STATE(ksCurThread)->benchmark.kernel_utilisation += exit - ksEnter;
         NODE_STATE(benchmark_kernel_number_entries)++;
         NODE_STATE(benchmark_kernel_time) += exit - ksEnter;
+        benchmark_utilisation_sched_exit(exit);
     }
+#ifdef CONFIG_BENCHMARK_TRACK_UTILISATION_PMU
+    benchmark_utilisation_pmu_exit();
+#endif
 #endif /* CONFIG_BENCHMARK_TRACK_UTILISATION */
+#ifdef CONFIG_BENCHMARK_IRQ_LATENCY
+    benchmark_irq_latency_exit();
+#endif
+#ifdef CONFIG_BENCHMARK_PREEMPTION_LATENCY
+    benchmark_preemption_exit();
+#endif
 
     arch_c_exit_hook();
 }
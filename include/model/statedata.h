@@ -11,6 +11,9 @@
 #include <object/structures.h>
 #include <object/tcb.h>
 #include <mode/types.h>
+#include <sel4/benchmark_fastpath_types.h>
+#include <sel4/benchmark_preemption_types.h>
+#include <sel4/benchmark_irq_types.h>
 
 #ifdef ENABLE_SMP_SUPPORT
 #define NODE_STATE_BEGIN(_name)                 typedef struct _name {
@@ -88,7 +91,45 @@ NODE_STATE_DECLARE(timestamp_t, benchmark_end_time);
 NODE_STATE_DECLARE(timestamp_t, benchmark_kernel_time);
 NODE_STATE_DECLARE(timestamp_t, benchmark_kernel_number_entries);
 NODE_STATE_DECLARE(timestamp_t, benchmark_kernel_number_schedules);
+/* Time of the last kernel exit */
+NODE_STATE_DECLARE(timestamp_t, benchmark_exit_time);
+NODE_STATE_DECLARE(uint64_t, benchmark_domain_utilisation[CONFIG_NUM_DOMAINS][BENCHMARK_DOMAIN_NUM_COUNTERS]);
+#ifdef CONFIG_KERNEL_MCS
+NODE_STATE_DECLARE(benchmark_sc_util_t, benchmark_sc_utilisation[CONFIG_BENCHMARK_TRACK_UTILISATION_SCHED_CONTEXTS]);
+NODE_STATE_DECLARE(word_t, benchmark_sc_utilisation_overflow);
+#endif /* CONFIG_KERNEL_MCS */
+#ifdef CONFIG_BENCHMARK_TRACK_UTILISATION_PMU
+/* PMU event counters as read on the last kernel entry and exit */
+NODE_STATE_DECLARE(uint32_t, benchmark_pmu_enter[BENCHMARK_PMU_NUM_EVENTS]);
+NODE_STATE_DECLARE(uint32_t, benchmark_pmu_exit[BENCHMARK_PMU_NUM_EVENTS]);
+#endif /* CONFIG_BENCHMARK_TRACK_UTILISATION_PMU */
 #endif /* CONFIG_BENCHMARK_TRACK_UTILISATION */
+#ifdef CONFIG_BENCHMARK_TRACK_KERNEL_ENTRIES_RING
+/* Slot of this core's kernel entry ring that is written next */
+NODE_STATE_DECLARE(word_t, ksLogRingSlot);
+#endif /* CONFIG_BENCHMARK_TRACK_KERNEL_ENTRIES_RING */
+#ifdef CONFIG_BENCHMARK_SAMPLE_PROFILE
+/* Number of samples in this core's sample log, which is only published to it */
+NODE_STATE_DECLARE(word_t, ksLogSampleCount);
+#endif /* CONFIG_BENCHMARK_SAMPLE_PROFILE */
+#ifdef CONFIG_BENCHMARK_SCHED_TRACE
+/* Number of events in this core's event log, which is only published to it */
+NODE_STATE_DECLARE(word_t, ksLogSchedCount);
+#endif /* CONFIG_BENCHMARK_SCHED_TRACE */
+#ifdef CONFIG_BENCHMARK_FASTPATH_COUNTERS
+NODE_STATE_DECLARE(uint64_t, ksFastpathCounters[BENCHMARK_FASTPATH_NUM_PATHS][BENCHMARK_FASTPATH_NUM_COUNTERS]);
+#endif /* CONFIG_BENCHMARK_FASTPATH_COUNTERS */
+#ifdef CONFIG_BENCHMARK_IRQ_LATENCY
+NODE_STATE_DECLARE(benchmark_irq_latency_pending_t, ksIRQLatency);
+#endif /* CONFIG_BENCHMARK_IRQ_LATENCY */
+#ifdef CONFIG_BENCHMARK_PREEMPTION_LATENCY
+NODE_STATE_DECLARE(uint64_t, ksPreemptionCounters[BENCHMARK_PREEMPTION_NUM_OPS][BENCHMARK_PREEMPTION_NUM_COUNTERS]);
+/* Long-running operation that ran last */
+NODE_STATE_DECLARE(word_t, ksPreemptionOp);
+/* Time of the last preemption point or IRQ check, or of kernel entry */
+NODE_STATE_DECLARE(timestamp_t, ksPreemptionLastPoint);
+NODE_STATE_DECLARE(timestamp_t, ksPreemptionLastCheck);
+#endif /* CONFIG_BENCHMARK_PREEMPTION_LATENCY */
 
 NODE_STATE_END(nodeState);
 
@@ -122,6 +163,8 @@ extern char ksIdleThreadSC[CONFIG_MAX_NUM_NODES][BIT(seL4_MinSchedContextBits)];
 
 #ifdef CONFIG_KERNEL_LOG_BUFFER
 extern paddr_t ksUserLogBuffer;
+extern seL4_Word ksLogIndex;
+extern seL4_Word ksLogIndexFinalized;
 #endif /* CONFIG_KERNEL_LOG_BUFFER */
 
 #define SchedulerAction_ResumeCurrentThread ((tcb_t*)0)
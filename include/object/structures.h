@@ -325,6 +325,15 @@ typedef struct debug_tcb debug_tcb_t;
 #define TCB_PTR_DEBUG_PTR(p) ((debug_tcb_t *)TCB_PTR_CTE_PTR(p,tcbArchCNodeEntries))
 #endif /* CONFIG_DEBUG_BUILD */
 
+#ifdef CONFIG_BENCHMARK_TRACK_UTILISATION_PMU
+/* PMU event counts are placed at the end of the 'unused' region of a TCB
+   object, immediately below the tcb_t itself. */
+#define TCB_PMU_UTIL_SIZE sizeof(benchmark_pmu_util_t)
+#define TCB_PTR_PMU_PTR(p) ((benchmark_pmu_util_t *)((word_t)(p) - TCB_PMU_UTIL_SIZE))
+#else
+#define TCB_PMU_UTIL_SIZE 0
+#endif /* CONFIG_BENCHMARK_TRACK_UTILISATION_PMU */
+
 #ifdef CONFIG_KERNEL_MCS
 typedef struct refill {
     /* Absolute timestamp from when this refill can be used */
@@ -405,6 +414,8 @@ compile_assert(tcb_size_sane,
                BIT(TCB_SIZE_BITS) >= sizeof(tcb_t))
 compile_assert(tcb_size_not_excessive,
                BIT(TCB_SIZE_BITS - 1) < sizeof(tcb_t))
+compile_assert(tcb_unused_size_sane,
+               BIT(TCB_SIZE_BITS) >= tcbCNodeEntries * sizeof(cte_t) + TCB_PMU_UTIL_SIZE)
 compile_assert(ep_size_sane, sizeof(endpoint_t) == BIT(seL4_EndpointBits))
 compile_assert(notification_size_sane, sizeof(notification_t) == BIT(seL4_NotificationBits))
 
@@ -15,7 +15,7 @@
 
 #ifdef CONFIG_DEBUG_BUILD
 /* Maximum length of the tcb name, including null terminator */
-#define TCB_NAME_LENGTH (BIT(seL4_TCBBits-1) - (tcbCNodeEntries * sizeof(cte_t)) - sizeof(debug_tcb_t))
+#define TCB_NAME_LENGTH (BIT(seL4_TCBBits-1) - (tcbCNodeEntries * sizeof(cte_t)) - sizeof(debug_tcb_t) - TCB_PMU_UTIL_SIZE)
 compile_assert(tcb_name_fits, TCB_NAME_LENGTH > 0)
 #endif
 
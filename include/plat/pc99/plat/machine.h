@@ -27,7 +27,12 @@ typedef enum _interrupt_t {
     int_irq_isa_min             = IRQ_INT_OFFSET, /* Beginning of PIC IRQs */
     int_irq_isa_max             = IRQ_INT_OFFSET + PIC_IRQ_LINES - 1, /* End of PIC IRQs */
     int_irq_user_min            = IRQ_INT_OFFSET + PIC_IRQ_LINES, /* First user available vector */
+#ifdef CONFIG_BENCHMARK_SAMPLE_PROFILE
+    int_irq_user_max            = 154,
+    int_pmu                     = 155,
+#else
     int_irq_user_max            = 155,
+#endif
 #ifdef CONFIG_IOMMU
     int_iommu                   = 156,
 #endif
@@ -50,6 +55,9 @@ typedef enum _platform_irq_t {
     irq_isa_max                 = int_irq_isa_max     - IRQ_INT_OFFSET,
     irq_user_min                = int_irq_user_min    - IRQ_INT_OFFSET,
     irq_user_max                = int_irq_user_max    - IRQ_INT_OFFSET,
+#ifdef CONFIG_BENCHMARK_SAMPLE_PROFILE
+    irq_pmu                     = int_pmu             - IRQ_INT_OFFSET,
+#endif
 #ifdef CONFIG_IOMMU
     irq_iommu                   = int_iommu           - IRQ_INT_OFFSET,
 #endif
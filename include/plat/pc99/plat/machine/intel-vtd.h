@@ -12,6 +12,14 @@
 
 void invalidate_iotlb(void);
 void invalidate_context_cache(void);
+#ifdef CONFIG_IOMMU_QUEUED_INVALIDATION
+/* queue invalidations, they take effect at the next vtd_flush_invalidations */
+void vtd_invalidate_iotlb_page(uint16_t domain_id, word_t io_address);
+void vtd_invalidate_iotlb_domain(uint16_t domain_id);
+void vtd_invalidate_context_domain(uint16_t domain_id);
+/* submit all queued invalidations and wait for them to complete */
+void vtd_flush_invalidations(void);
+#endif
 void vtd_handle_fault(void);
 /* calculate the number of IOPTs needed to map the rmrr regions */
 word_t vtd_get_n_paging(acpi_rmrr_list_t *rmrr_list);
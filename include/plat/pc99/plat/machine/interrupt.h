@@ -18,6 +18,7 @@
 #include <plat/machine/ioapic.h>
 #include <plat/machine/pic.h>
 #include <plat/machine/intel-vtd.h>
+#include <arch/benchmark.h>
 
 static inline void handleReservedIRQ(irq_t irq)
 {
@@ -28,6 +29,13 @@ static inline void handleReservedIRQ(irq_t irq)
     }
 #endif
 
+#ifdef CONFIG_BENCHMARK_SAMPLE_PROFILE
+    if (irq == irq_pmu) {
+        x86_handle_sample_overflow();
+        return;
+    }
+#endif
+
 #ifdef CONFIG_IRQ_REPORTING
     printf("Received unhandled reserved IRQ: %d\n", (int)irq);
 #endif
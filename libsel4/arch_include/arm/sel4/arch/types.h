@@ -40,3 +40,10 @@ typedef enum {
     SEL4_FORCE_LONG_ENUM(seL4_ARM_CacheType),
 } seL4_ARM_CacheType;
 
+typedef struct seL4_ARM_VCPURegBatch_ {
+    /* The (field, value) pairs of a batch of at most seL4_VCPURegBatchSize
+     * registers, as laid out in the message */
+    seL4_Word field0, value0, field1, value1, field2, value2, field3, value3;
+    seL4_Word field4, value4, field5, value5, field6, value6, field7, value7;
+} seL4_ARM_VCPURegBatch;
+
@@ -54,3 +54,10 @@ typedef struct seL4_VCPUContext_ {
     seL4_Word r8, r9, r10, r11, r12, r13, r14, r15;
 #endif
 } seL4_VCPUContext;
+
+typedef struct seL4_X86_VMCSBatch_ {
+    /* The (field, value) pairs of a batch of at most seL4_VCPURegBatchSize
+     * registers, as laid out in the message */
+    seL4_Word field0, value0, field1, value1, field2, value2, field3, value3;
+    seL4_Word field4, value4, field5, value5, field6, value6, field7, value7;
+} seL4_X86_VMCSBatch;
@@ -0,0 +1,69 @@
+/*
+ * Copyright 2026, seL4 Project a Series of LF Projects, LLC
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <sel4/config.h>
+
+#ifdef CONFIG_BENCHMARK_FASTPATH_COUNTERS
+
+/* Fastpaths with counters */
+enum benchmark_fastpath {
+    BENCHMARK_FASTPATH_CALL,
+    BENCHMARK_FASTPATH_REPLY_RECV,
+    BENCHMARK_FASTPATH_SIGNAL,
+    BENCHMARK_FASTPATH_NUM_PATHS
+};
+
+/* Counters kept for each fastpath. Apart from BENCHMARK_FASTPATH_HIT, each
+ * counts the fastpath being left for the slowpath because of a failed check. */
+enum benchmark_fastpath_counter {
+    /* The fastpath completed the syscall */
+    BENCHMARK_FASTPATH_HIT,
+    /* Extra caps, a message too long or a saved fault on the current thread */
+    BENCHMARK_FASTPATH_MISS_MSGINFO,
+    /* The invoked cap is of the wrong type or lacks rights */
+    BENCHMARK_FASTPATH_MISS_CAP,
+    /* No thread waiting to receive for a call, or a thread waiting to send
+     * for a reply_recv */
+    BENCHMARK_FASTPATH_MISS_EP_STATE,
+    /* The bound notification of the current thread is active */
+    BENCHMARK_FASTPATH_MISS_NTFN,
+    /* The reply cap or reply object is not valid */
+    BENCHMARK_FASTPATH_MISS_REPLY,
+    /* The thread replied to has faulted */
+    BENCHMARK_FASTPATH_MISS_FAULT,
+    /* The destination thread is single stepped */
+    BENCHMARK_FASTPATH_MISS_DEBUG,
+    /* The destination thread has no valid VSpace root */
+    BENCHMARK_FASTPATH_MISS_VSPACE,
+    /* The ASID, hardware ASID or VMID of the destination is not valid */
+    BENCHMARK_FASTPATH_MISS_ASID,
+    /* The destination thread would not be the highest priority runnable thread,
+     * or for a signal would preempt the thread running on its core */
+    BENCHMARK_FASTPATH_MISS_PRIORITY,
+    /* The endpoint cap has neither grant nor grant-reply rights */
+    BENCHMARK_FASTPATH_MISS_GRANT,
+    /* The destination is in another domain, or the current domain has expired */
+    BENCHMARK_FASTPATH_MISS_DOMAIN,
+    /* A scheduling context would have to be donated in a way the fastpath
+     * does not handle */
+    BENCHMARK_FASTPATH_MISS_SCHED_CONTEXT,
+    /* The scheduling context of the destination has insufficient budget */
+    BENCHMARK_FASTPATH_MISS_BUDGET,
+    /* The destination thread has a different affinity */
+    BENCHMARK_FASTPATH_MISS_AFFINITY,
+    /* The FPU context of the destination thread is loaded on a core */
+    BENCHMARK_FASTPATH_MISS_FPU,
+    BENCHMARK_FASTPATH_NUM_COUNTERS
+};
+
+/* seL4_BenchmarkGetFastpathCounters writes the counters of a core to the IPC
+ * buffer as uint64_t, counter c of path p at index
+ * p * BENCHMARK_FASTPATH_NUM_COUNTERS + c */
+#define BENCHMARK_FASTPATH_IPC_COUNTERS (BENCHMARK_FASTPATH_NUM_PATHS * BENCHMARK_FASTPATH_NUM_COUNTERS)
+
+#endif /* CONFIG_BENCHMARK_FASTPATH_COUNTERS */
@@ -0,0 +1,25 @@
+/*
+ * Copyright 2026, seL4 Project a Series of LF Projects, LLC
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <sel4/macros.h>
+#include <stdint.h>
+
+/* Log-linear latency histograms over the 32-bit duration range.
+ *
+ * Durations below BIT(seL4_LogHistogramSubBucketBits) have a bucket each. Above
+ * that, every power of two is split into BIT(seL4_LogHistogramSubBucketBits)
+ * buckets of equal width. */
+#define seL4_LogHistogramSubBucketBits 2
+#define seL4_LogHistogramBuckets ((32 - seL4_LogHistogramSubBucketBits + 1) << seL4_LogHistogramSubBucketBits)
+
+/* Smallest duration counted in bucket i */
+#define seL4_LogHistogramBucketBase(i) \
+    ((i) < LIBSEL4_BIT(seL4_LogHistogramSubBucketBits) ? (uint32_t)(i) : \
+     (uint32_t)(LIBSEL4_BIT(seL4_LogHistogramSubBucketBits) | \
+                ((i) & (LIBSEL4_BIT(seL4_LogHistogramSubBucketBits) - 1))) << \
+     (((i) >> seL4_LogHistogramSubBucketBits) - 1))
@@ -0,0 +1,93 @@
+/*
+ * Copyright 2026, seL4 Project a Series of LF Projects, LLC
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <sel4/config.h>
+#include <sel4/benchmark_histogram_types.h>
+#include <stdint.h>
+
+#ifdef CONFIG_BENCHMARK_IRQ_LATENCY
+
+/* Stages of handling an interrupt. Each is timed from the kernel entry during
+ * which the interrupt was handled. */
+enum benchmark_irq_latency_stage_index {
+    /* handleInterrupt starts handling the IRQ */
+    BENCHMARK_IRQ_LATENCY_DISPATCH,
+    /* The notification of the IRQ handler cap has been signalled */
+    BENCHMARK_IRQ_LATENCY_SIGNAL,
+    /* The thread woken by the signal resumes at user level */
+    BENCHMARK_IRQ_LATENCY_USER,
+    BENCHMARK_IRQ_LATENCY_NUM_STAGES
+};
+
+/**
+ * @brief Latencies of one stage
+ *
+ * Only interrupts that reached the stage are counted. buckets is a histogram
+ * as described in sel4/benchmark_histogram_types.h.
+ */
+typedef struct benchmark_irq_latency_stage {
+    uint32_t count;
+    uint32_t min;
+    uint32_t max;
+    uint32_t padding;
+    uint64_t total;
+    uint32_t buckets[seL4_LogHistogramBuckets];
+} benchmark_irq_latency_stage_t;
+
+/**
+ * @brief Latencies of one IRQ delivered to one thread
+ *
+ * tcb is the kernel address of the TCB woken by the signal, or 0 if the
+ * interrupt woke no thread. This is the case when nobody waited on the
+ * notification and for interrupts the kernel handles itself. The user stage
+ * is only reached by threads woken on the core that handled the interrupt, and
+ * only if they run before the next interrupt is handled on that core.
+ * A record with no dispatched interrupts is unused.
+ */
+typedef struct benchmark_irq_latency {
+    seL4_Word irq;
+    seL4_Word tcb;
+    benchmark_irq_latency_stage_t stages[BENCHMARK_IRQ_LATENCY_NUM_STAGES];
+} benchmark_irq_latency_t;
+
+/**
+ * @brief Per-core table of IRQ latency records
+ *
+ * The log buffer holds one table per core, core n's table starting at offset
+ * n * seL4_LogIRQLatencyTableSize. Interrupts whose record does not fit into a
+ * full table are counted in overflow.
+ */
+typedef struct benchmark_irq_latency_table {
+    seL4_Word used;
+    seL4_Word overflow;
+    benchmark_irq_latency_t records[];
+} benchmark_irq_latency_table_t;
+
+/* The interrupt traced on a core, from its dispatch until its latencies are
+ * added to the core's table. This is only used by the kernel. */
+typedef struct benchmark_irq_latency_pending {
+    /* Time of the latest kernel entry */
+    uint64_t kernel_enter;
+    /* Time of the kernel entry during which the IRQ was handled */
+    uint64_t enter;
+    uint32_t latency[BENCHMARK_IRQ_LATENCY_NUM_STAGES];
+    /* Bitmap of the stages reached */
+    seL4_Word reached;
+    seL4_Word irq;
+    /* Kernel address of the thread woken by the signal */
+    seL4_Word tcb;
+    /* The woken thread runs on another core */
+    seL4_Bool remote;
+    seL4_Bool active;
+} benchmark_irq_latency_pending_t;
+
+#define seL4_LogIRQLatencyTableSize (seL4_LogBufferSize / CONFIG_MAX_NUM_NODES)
+#define seL4_LogIRQLatencies ((seL4_LogIRQLatencyTableSize - sizeof(benchmark_irq_latency_table_t)) / \
+                              sizeof(benchmark_irq_latency_t))
+
+#endif /* CONFIG_BENCHMARK_IRQ_LATENCY */
@@ -0,0 +1,58 @@
+/*
+ * Copyright 2026, seL4 Project a Series of LF Projects, LLC
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <sel4/config.h>
+
+#ifdef CONFIG_BENCHMARK_PREEMPTION_LATENCY
+
+/* Kinds of long-running operations. The intervals below are attributed to the
+ * innermost operation that ran during them, so the time spent in e.g.
+ * cancelAllIPC while deleting an endpoint is not charged to the deletion. */
+enum benchmark_preemption_op {
+    /* No long-running operation during this kernel entry */
+    BENCHMARK_PREEMPTION_OP_NONE,
+    /* cteRevoke, from seL4_CNode_Revoke */
+    BENCHMARK_PREEMPTION_OP_REVOKE,
+    /* finaliseSlot, for every cteDelete */
+    BENCHMARK_PREEMPTION_OP_DELETE,
+    /* resetUntypedCap, from seL4_Untyped_Retype */
+    BENCHMARK_PREEMPTION_OP_RESET_UNTYPED,
+    /* cancelAllIPC and cancelBadgedSends, which are not preemptible */
+    BENCHMARK_PREEMPTION_OP_CANCEL_IPC,
+    /* cancelAllSignals, which is not preemptible */
+    BENCHMARK_PREEMPTION_OP_CANCEL_SIGNALS,
+    /* deleteASIDPool, which is not preemptible */
+    BENCHMARK_PREEMPTION_OP_DELETE_ASID_POOL,
+    BENCHMARK_PREEMPTION_NUM_OPS
+};
+
+/* Counters kept for each kind of operation. Intervals are in timestamp() units
+ * and start at kernel entry or the previous preemption point or IRQ check, and
+ * end at the next one or at kernel exit. An interval is also split where a
+ * different operation starts or ends. */
+enum benchmark_preemption_counter {
+    /* Calls to preemptionPoint */
+    BENCHMARK_PREEMPTION_POINTS,
+    /* Checks for pending interrupts, made every
+     * CONFIG_MAX_NUM_WORK_UNITS_PER_PREEMPTION preemption points */
+    BENCHMARK_PREEMPTION_IRQ_CHECKS,
+    /* Checks that preempted the operation */
+    BENCHMARK_PREEMPTION_PREEMPTED,
+    /* Longest interval without a preemption point */
+    BENCHMARK_PREEMPTION_MAX_POINT_INTERVAL,
+    /* Longest interval without an IRQ check */
+    BENCHMARK_PREEMPTION_MAX_CHECK_INTERVAL,
+    BENCHMARK_PREEMPTION_NUM_COUNTERS
+};
+
+/* seL4_BenchmarkGetPreemptionCounters writes the counters of a core to the IPC
+ * buffer as uint64_t, counter c of operation o at index
+ * o * BENCHMARK_PREEMPTION_NUM_COUNTERS + c */
+#define BENCHMARK_PREEMPTION_IPC_COUNTERS (BENCHMARK_PREEMPTION_NUM_OPS * BENCHMARK_PREEMPTION_NUM_COUNTERS)
+
+#endif /* CONFIG_BENCHMARK_PREEMPTION_LATENCY */
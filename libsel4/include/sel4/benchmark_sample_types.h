@@ -0,0 +1,52 @@
+/*
+ * Copyright 2026, seL4 Project a Series of LF Projects, LLC
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <sel4/config.h>
+#include <stdint.h>
+
+#ifdef CONFIG_BENCHMARK_SAMPLE_PROFILE
+
+/**
+ * @brief One sample taken on a PMU overflow interrupt
+ *
+ * tcb is the kernel address of the TCB of the interrupted thread and pc its
+ * program counter. kernel is set when the interrupted thread is the idle
+ * thread, which runs in kernel mode. frames holds the return addresses of the
+ * enclosing user-level stack frames, innermost first, and is zero filled after
+ * the last frame found.
+ */
+typedef struct benchmark_sample {
+    uint64_t time;
+    seL4_Word tcb;
+    seL4_Word pc;
+    uint32_t core;
+    uint32_t kernel;
+#if CONFIG_BENCHMARK_SAMPLE_PROFILE_USER_FRAMES > 0
+    seL4_Word frames[CONFIG_BENCHMARK_SAMPLE_PROFILE_USER_FRAMES];
+#endif
+} benchmark_sample_t;
+
+/**
+ * @brief Per-core log of samples
+ *
+ * The log buffer holds one sample log per core, core n's log starting at
+ * offset n * seL4_LogSampleLogSize. Samples taken while the log is full are
+ * counted in dropped. count is only published by the kernel, which keeps its
+ * own copy, so changing it from user level has no effect.
+ */
+typedef struct benchmark_sample_log {
+    seL4_Word count;
+    seL4_Word dropped;
+    benchmark_sample_t samples[];
+} benchmark_sample_log_t;
+
+#define seL4_LogSampleLogSize (seL4_LogBufferSize / CONFIG_MAX_NUM_NODES)
+#define seL4_LogSamples ((seL4_LogSampleLogSize - sizeof(benchmark_sample_log_t)) / \
+                         sizeof(benchmark_sample_t))
+
+#endif /* CONFIG_BENCHMARK_SAMPLE_PROFILE */
@@ -0,0 +1,70 @@
+/*
+ * Copyright 2026, seL4 Project a Series of LF Projects, LLC
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <sel4/config.h>
+#include <stdint.h>
+
+#ifdef CONFIG_BENCHMARK_SCHED_TRACE
+
+/* Kinds of scheduler events. tcb is the kernel address of the TCB the event is
+ * about, arg is described for each kind. */
+enum benchmark_sched_event_type {
+    /* tcb starts running on the core. arg is its priority, or -1 for the idle
+     * thread. */
+    BENCHMARK_SCHED_SWITCH,
+    /* tcb became runnable. arg is its new thread state. */
+    BENCHMARK_SCHED_WAKE,
+    /* tcb stopped being runnable. arg is its new thread state, the reason it
+     * blocked. */
+    BENCHMARK_SCHED_BLOCK,
+    /* The domain schedule advanced. tcb is 0 and arg the new domain. */
+    BENCHMARK_SCHED_DOMAIN,
+    /* The scheduling context bound to tcb was charged. arg is the consumed time
+     * in ticks. */
+    BENCHMARK_SCHED_BUDGET,
+    /* tcb ran out of budget and was moved to the release queue. arg is the
+     * release time of its next refill in ticks. */
+    BENCHMARK_SCHED_POSTPONE,
+    /* tcb was taken off the release queue as its next refill became ready */
+    BENCHMARK_SCHED_RELEASE,
+    BENCHMARK_SCHED_NUM_EVENT_TYPES
+};
+
+/**
+ * @brief One scheduler event
+ *
+ * The layout does not depend on the word size, so that tools/sched_trace_json.py
+ * can read the logs of any architecture. time is a timestamp() of the core.
+ */
+typedef struct benchmark_sched_event {
+    uint64_t time;
+    uint64_t tcb;
+    uint64_t arg;
+    uint32_t type;
+    uint32_t core;
+} benchmark_sched_event_t;
+
+/**
+ * @brief Per-core log of scheduler events
+ *
+ * The log buffer holds one event log per core, core n's log starting at
+ * offset n * seL4_LogSchedLogSize. Events that happen while the log is full
+ * are counted in dropped. count is only published by the kernel, which keeps
+ * its own copy, so changing it from user level has no effect.
+ */
+typedef struct benchmark_sched_log {
+    uint64_t count;
+    uint64_t dropped;
+    benchmark_sched_event_t events[];
+} benchmark_sched_log_t;
+
+#define seL4_LogSchedLogSize (seL4_LogBufferSize / CONFIG_MAX_NUM_NODES)
+#define seL4_LogSchedEvents ((seL4_LogSchedLogSize - sizeof(benchmark_sched_log_t)) / \
+                             sizeof(benchmark_sched_event_t))
+
+#endif /* CONFIG_BENCHMARK_SCHED_TRACE */
@@ -7,6 +7,7 @@
 #pragma once
 
 #include <sel4/config.h>
+#include <sel4/benchmark_histogram_types.h>
 #include <stdint.h>
 
 #if (defined CONFIG_BENCHMARK_TRACK_KERNEL_ENTRIES || defined CONFIG_DEBUG_BUILD)
@@ -61,4 +62,68 @@ typedef struct benchmark_syscall_log_entry {
     kernel_entry_t entry;
 } benchmark_track_kernel_entry_t;
 
+#ifdef CONFIG_BENCHMARK_TRACK_KERNEL_ENTRIES_RING
+
+/**
+ * @brief Per-core ring of kernel entries
+ *
+ * The log buffer holds one ring per core, core n's ring starting at offset
+ * n * seL4_LogRingSize. head and tail count the entries written and consumed
+ * since the log was last reset; entry i is stored at entries[i % seL4_LogRingEntries].
+ * The kernel only advances head and dropped, the consumer only advances tail.
+ * They are kept on separate cache lines.
+ */
+typedef struct benchmark_track_ring {
+    seL4_Word head;
+    seL4_Word dropped;
+    uint8_t padding0[64 - 2 * sizeof(seL4_Word)];
+    seL4_Word tail;
+    uint8_t padding1[64 - sizeof(seL4_Word)];
+    benchmark_track_kernel_entry_t entries[];
+} benchmark_track_ring_t;
+
+#define seL4_LogRingSize (seL4_LogBufferSize / CONFIG_MAX_NUM_NODES)
+#define seL4_LogRingEntries ((seL4_LogRingSize - sizeof(benchmark_track_ring_t)) / \
+                             sizeof(benchmark_track_kernel_entry_t))
+
+#endif /* CONFIG_BENCHMARK_TRACK_KERNEL_ENTRIES_RING */
+
+#ifdef CONFIG_BENCHMARK_TRACK_KERNEL_ENTRIES_HISTOGRAM
+
+/**
+ * @brief Latency histogram of one kind of kernel entry
+ *
+ * For syscalls the key holds path, syscall_no, cap_type and invocation_tag,
+ * with is_fastpath cleared. For all other entries it only holds the path.
+ * A histogram with a count of zero is unused.
+ */
+typedef struct benchmark_track_histogram {
+    kernel_entry_t key;
+    uint32_t count;
+    uint32_t max_duration;
+    uint32_t padding;
+    uint64_t max_start_time;
+    uint64_t total_duration;
+    uint32_t buckets[seL4_LogHistogramBuckets];
+} benchmark_track_histogram_t;
+
+/**
+ * @brief Per-core table of latency histograms
+ *
+ * The log buffer holds one table per core, core n's table starting at offset
+ * n * seL4_LogHistogramTableSize. Entries that do not fit into a full table
+ * are counted in overflow.
+ */
+typedef struct benchmark_track_histogram_table {
+    seL4_Word used;
+    seL4_Word overflow;
+    benchmark_track_histogram_t histograms[];
+} benchmark_track_histogram_table_t;
+
+#define seL4_LogHistogramTableSize (seL4_LogBufferSize / CONFIG_MAX_NUM_NODES)
+#define seL4_LogHistograms ((seL4_LogHistogramTableSize - sizeof(benchmark_track_histogram_table_t)) / \
+                            sizeof(benchmark_track_histogram_t))
+
+#endif /* CONFIG_BENCHMARK_TRACK_KERNEL_ENTRIES_HISTOGRAM */
+
 #endif /* CONFIG_BENCHMARK_TRACK_KERNEL_ENTRIES || CONFIG_DEBUG_BUILD */
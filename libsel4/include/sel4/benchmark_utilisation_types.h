@@ -40,6 +40,59 @@ enum benchmark_track_util_ipc_index {
     BENCHMARK_TOTAL_KERNEL_UTILISATION,
     /* Total number of times the kernel is entered on the current core */
     BENCHMARK_TOTAL_NUMBER_KERNEL_ENTRIES,
+
+#ifdef CONFIG_BENCHMARK_TRACK_UTILISATION_PMU
+    /* BENCHMARK_PMU_NUM_EVENTS counts of the PMU events in
+     * CONFIG_BENCHMARK_TRACK_UTILISATION_PMU_EVENTS while the thread ran at user
+     * level, followed by as many counts while the kernel ran on its behalf */
+    BENCHMARK_TCB_PMU_COUNTERS,
+#endif
+};
+
+/* seL4_BenchmarkGetDomainUtilisation writes these counters of the domain for
+ * each core to the IPC buffer as uint64_t, counter c of core n at index
+ * n * BENCHMARK_DOMAIN_NUM_COUNTERS + c. Counters are only kept by cores
+ * between seL4_BenchmarkResetLog and seL4_BenchmarkFinalizeLog on that core. */
+enum benchmark_domain_util_ipc_index {
+    /* Number of cycles threads other than the idle thread ran in the domain,
+     * including the kernel time spent on their behalf */
+    BENCHMARK_DOMAIN_UTILISATION,
+    /* Number of cycles the idle thread ran in the domain */
+    BENCHMARK_DOMAIN_IDLE_UTILISATION,
+    /* Number of cycles spent in the kernel while the domain was current */
+    BENCHMARK_DOMAIN_KERNEL_UTILISATION,
+    /* Number of kernel entries while the domain was current */
+    BENCHMARK_DOMAIN_NUMBER_KERNEL_ENTRIES,
+    BENCHMARK_DOMAIN_NUM_COUNTERS
 };
 
+#ifdef CONFIG_KERNEL_MCS
+/* seL4_BenchmarkGetSchedContextUtilisation writes these counters of the
+ * scheduling context, summed over all cores, to the IPC buffer as uint64_t */
+enum benchmark_sc_util_ipc_index {
+    /* Number of cycles threads ran on the scheduling context, including the
+     * kernel time spent on their behalf */
+    BENCHMARK_SC_UTILISATION,
+    /* The part of BENCHMARK_SC_UTILISATION during which the scheduling context
+     * was donated over a call, so ran a server on behalf of a caller */
+    BENCHMARK_SC_DONATED_UTILISATION,
+    /* Number of cycles spent in the kernel while the scheduling context was
+     * current */
+    BENCHMARK_SC_KERNEL_UTILISATION,
+    /* Number of kernel entries while the scheduling context was current */
+    BENCHMARK_SC_NUMBER_KERNEL_ENTRIES,
+    /* Number of ticks charged to the budget of the scheduling context */
+    BENCHMARK_SC_CONSUMED,
+    BENCHMARK_SC_NUM_COUNTERS,
+    /* Number of times a scheduling context could not be accounted as the
+     * table of a core was full, on all cores */
+    BENCHMARK_SC_TABLE_OVERFLOW = BENCHMARK_SC_NUM_COUNTERS,
+};
+#endif /* CONFIG_KERNEL_MCS */
+
+#ifdef CONFIG_BENCHMARK_TRACK_UTILISATION_PMU
+#define BENCHMARK_PMU_NUM_EVENTS \
+    (sizeof((unsigned long[]) { CONFIG_BENCHMARK_TRACK_UTILISATION_PMU_EVENTS }) / sizeof(unsigned long))
+#endif
+
 #endif /* CONFIG_BENCHMARK_TRACK_UTILISATION */
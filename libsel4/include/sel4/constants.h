@@ -107,6 +107,11 @@ typedef enum {
 #endif /* !__ASSEMBLER__ */
 #endif /* CONFIG_KERNEL_MCS */
 
+#ifdef CONFIG_VCPU_REG_BATCH
+/* Number of (field, value) pairs of the VCPU register batch invocations */
+#define seL4_VCPURegBatchSize 8
+#endif
+
 #ifdef CONFIG_KERNEL_INVOCATION_REPORT_ERROR_IPC
 #define DEBUG_MESSAGE_START 6
 #define DEBUG_MESSAGE_MAXLEN 50
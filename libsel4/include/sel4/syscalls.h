@@ -283,6 +283,37 @@ seL4_BenchmarkGetThreadUtilisation(seL4_Word tcb_cptr);
 LIBSEL4_INLINE_FUNC void
 seL4_BenchmarkResetThreadUtilisation(seL4_Word tcb_cptr);
 
+/**
+ * @xmlonly <manual name="Get Domain Utilisation" label="sel4_benchmarkgetdomainutilisation"/> @endxmlonly
+ * @brief Get utilisation timing information of a domain.
+ *
+ * Get the time threads and the idle thread ran in the given domain, and the time spent in the kernel while
+ * it was current, on each core. Such information is written into the caller's IPC buffer; see the
+ * definition of the `benchmark_domain_util_ipc_index` enum for the format.
+ *
+ * @param[in] domain The domain to get the utilisation of.
+ * @return A `seL4_InvalidArgument` error if `domain` is not a valid domain or the caller has no IPC buffer.
+ */
+LIBSEL4_INLINE_FUNC seL4_Error
+seL4_BenchmarkGetDomainUtilisation(seL4_Word domain);
+
+#ifdef CONFIG_KERNEL_MCS
+/**
+ * @xmlonly <manual name="Get Scheduling Context Utilisation" label="sel4_benchmarkgetschedcontextutilisation"/> @endxmlonly
+ * @brief Get utilisation timing information of a scheduling context.
+ *
+ * Get the time threads ran on the given scheduling context, including while it was donated over a call,
+ * and the ticks charged to its budget, summed over all cores. Such information is written into the
+ * caller's IPC buffer; see the definition of the `benchmark_sc_util_ipc_index` enum for the format.
+ *
+ * @param[in] sc Capability to the scheduling context to get the utilisation of.
+ * @return A `seL4_InvalidCapability` error if `sc` is not a scheduling context capability or the caller
+ *         has no IPC buffer.
+ */
+LIBSEL4_INLINE_FUNC seL4_Error
+seL4_BenchmarkGetSchedContextUtilisation(seL4_CPtr sc);
+#endif
+
 #ifdef CONFIG_DEBUG_BUILD
 /**
  * @xmlonly <manual name="Dump All Threads Utilisation" label="sel4_benchmarkdumpallthreadsutilisation"/> @endxmlonly
@@ -306,6 +337,51 @@ seL4_BenchmarkResetAllThreadsUtilisation(void);
 
 #endif
 #endif
+
+#ifdef CONFIG_BENCHMARK_FASTPATH_COUNTERS
+/**
+ * @xmlonly <manual name="Get Fastpath Counters" label="sel4_benchmarkgetfastpathcounters"/> @endxmlonly
+ * @brief Get the fastpath counters of a core.
+ *
+ * Copy the counts of fastpath hits and of each reason for falling back to the slowpath on the given core
+ * into the caller's IPC buffer; see `sel4/benchmark_fastpath_types.h` for the layout.
+ *
+ * @param[in] core Index of the core to get the counters of.
+ * @return A `seL4_InvalidArgument` error if `core` is not a valid core or the caller has no IPC buffer.
+ */
+LIBSEL4_INLINE_FUNC seL4_Error
+seL4_BenchmarkGetFastpathCounters(seL4_Word core);
+
+/**
+ * @xmlonly <manual name="Reset Fastpath Counters" label="sel4_benchmarkresetfastpathcounters"/> @endxmlonly
+ * @brief Reset the fastpath counters of all cores to 0.
+ */
+LIBSEL4_INLINE_FUNC void
+seL4_BenchmarkResetFastpathCounters(void);
+#endif
+
+#ifdef CONFIG_BENCHMARK_PREEMPTION_LATENCY
+/**
+ * @xmlonly <manual name="Get Preemption Counters" label="sel4_benchmarkgetpreemptioncounters"/> @endxmlonly
+ * @brief Get the preemption point counters of a core.
+ *
+ * Copy the counts of preemption points, interrupt checks and preemptions, and the longest intervals
+ * without them, of each kind of long-running operation on the given core into the caller's IPC buffer;
+ * see `sel4/benchmark_preemption_types.h` for the layout.
+ *
+ * @param[in] core Index of the core to get the counters of.
+ * @return A `seL4_InvalidArgument` error if `core` is not a valid core or the caller has no IPC buffer.
+ */
+LIBSEL4_INLINE_FUNC seL4_Error
+seL4_BenchmarkGetPreemptionCounters(seL4_Word core);
+
+/**
+ * @xmlonly <manual name="Reset Preemption Counters" label="sel4_benchmarkresetpreemptioncounters"/> @endxmlonly
+ * @brief Reset the preemption point counters of all cores to 0.
+ */
+LIBSEL4_INLINE_FUNC void
+seL4_BenchmarkResetPreemptionCounters(void);
+#endif
 #endif
 /** @} */
 
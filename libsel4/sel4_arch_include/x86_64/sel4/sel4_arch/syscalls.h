@@ -765,6 +765,42 @@ LIBSEL4_INLINE_FUNC void seL4_BenchmarkResetThreadUtilisation(seL4_Word tcb_cptr
                       &unused4, &unused5, 0);
 }
 
+/* Copies the counters of domain on each core into the IPC buffer, laid out as
+ * described in sel4/benchmark_utilisation_types.h */
+LIBSEL4_INLINE_FUNC seL4_Error seL4_BenchmarkGetDomainUtilisation(seL4_Word domain)
+{
+    seL4_Word unused0 = 0;
+    seL4_Word unused1 = 0;
+    seL4_Word unused2 = 0;
+    seL4_Word unused3 = 0;
+    seL4_Word unused4 = 0;
+
+    seL4_Word ret;
+    x64_sys_send_recv(seL4_SysBenchmarkGetDomainUtilisation, domain, &ret, 0, &unused0, &unused1,
+                      &unused2, &unused3, &unused4, 0);
+
+    return (seL4_Error) ret;
+}
+
+#ifdef CONFIG_KERNEL_MCS
+/* Copies the counters of the scheduling context sc into the IPC buffer, laid
+ * out as described in sel4/benchmark_utilisation_types.h */
+LIBSEL4_INLINE_FUNC seL4_Error seL4_BenchmarkGetSchedContextUtilisation(seL4_CPtr sc)
+{
+    seL4_Word unused0 = 0;
+    seL4_Word unused1 = 0;
+    seL4_Word unused2 = 0;
+    seL4_Word unused3 = 0;
+    seL4_Word unused4 = 0;
+
+    seL4_Word ret;
+    x64_sys_send_recv(seL4_SysBenchmarkGetSchedContextUtilisation, sc, &ret, 0, &unused0, &unused1,
+                      &unused2, &unused3, &unused4, 0);
+
+    return (seL4_Error) ret;
+}
+#endif
+
 #ifdef CONFIG_DEBUG_BUILD
 LIBSEL4_INLINE_FUNC void seL4_BenchmarkDumpAllThreadsUtilisation(void)
 {
@@ -794,6 +830,68 @@ LIBSEL4_INLINE_FUNC void seL4_BenchmarkResetAllThreadsUtilisation(void)
 
 #endif
 #endif /* CONFIG_BENCHMARK_TRACK_UTILISATION */
+#ifdef CONFIG_BENCHMARK_FASTPATH_COUNTERS
+/* Copies the fastpath counters of core into the IPC buffer, laid out as
+ * described in sel4/benchmark_fastpath_types.h */
+LIBSEL4_INLINE_FUNC seL4_Error seL4_BenchmarkGetFastpathCounters(seL4_Word core)
+{
+    seL4_Word unused0 = 0;
+    seL4_Word unused1 = 0;
+    seL4_Word unused2 = 0;
+    seL4_Word unused3 = 0;
+    seL4_Word unused4 = 0;
+
+    seL4_Word ret;
+    x64_sys_send_recv(seL4_SysBenchmarkGetFastpathCounters, core, &ret, 0, &unused0, &unused1,
+                      &unused2, &unused3, &unused4, 0);
+
+    return (seL4_Error) ret;
+}
+
+LIBSEL4_INLINE_FUNC void seL4_BenchmarkResetFastpathCounters(void)
+{
+    seL4_Word unused0 = 0;
+    seL4_Word unused1 = 0;
+    seL4_Word unused2 = 0;
+    seL4_Word unused3 = 0;
+    seL4_Word unused4 = 0;
+    seL4_Word unused5 = 0;
+
+    x64_sys_send_recv(seL4_SysBenchmarkResetFastpathCounters, 0, &unused0, 0, &unused1, &unused2,
+                      &unused3, &unused4, &unused5, 0);
+}
+#endif /* CONFIG_BENCHMARK_FASTPATH_COUNTERS */
+#ifdef CONFIG_BENCHMARK_PREEMPTION_LATENCY
+/* Copies the preemption counters of core into the IPC buffer, laid out as
+ * described in sel4/benchmark_preemption_types.h */
+LIBSEL4_INLINE_FUNC seL4_Error seL4_BenchmarkGetPreemptionCounters(seL4_Word core)
+{
+    seL4_Word unused0 = 0;
+    seL4_Word unused1 = 0;
+    seL4_Word unused2 = 0;
+    seL4_Word unused3 = 0;
+    seL4_Word unused4 = 0;
+
+    seL4_Word ret;
+    x64_sys_send_recv(seL4_SysBenchmarkGetPreemptionCounters, core, &ret, 0, &unused0, &unused1,
+                      &unused2, &unused3, &unused4, 0);
+
+    return (seL4_Error) ret;
+}
+
+LIBSEL4_INLINE_FUNC void seL4_BenchmarkResetPreemptionCounters(void)
+{
+    seL4_Word unused0 = 0;
+    seL4_Word unused1 = 0;
+    seL4_Word unused2 = 0;
+    seL4_Word unused3 = 0;
+    seL4_Word unused4 = 0;
+    seL4_Word unused5 = 0;
+
+    x64_sys_send_recv(seL4_SysBenchmarkResetPreemptionCounters, 0, &unused0, 0, &unused1, &unused2,
+                      &unused3, &unused4, &unused5, 0);
+}
+#endif /* CONFIG_BENCHMARK_PREEMPTION_LATENCY */
 #endif /* CONFIG_ENABLE_BENCHMARKS */
 
 #ifdef CONFIG_SET_TLS_BASE_SELF
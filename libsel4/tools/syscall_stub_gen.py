@@ -280,6 +280,7 @@ def init_arch_types(wordsize, args):
             CapType("seL4_ARM_IOSpace", wordsize),
             CapType("seL4_ARM_IOPageTable", wordsize),
             StructType("seL4_UserContext", wordsize * 19, wordsize),
+            StructType("seL4_ARM_VCPURegBatch", wordsize * 16, wordsize),
             Type("seL4_VCPUReg", wordsize, wordsize),
         ] + arm_smmu,
 
@@ -296,6 +297,7 @@ def init_arch_types(wordsize, args):
             CapType("seL4_ARM_SMC", wordsize),
             StructType("seL4_UserContext", wordsize * 36, wordsize),
             StructType("seL4_ARM_SMCContext", wordsize * 8, wordsize),
+            StructType("seL4_ARM_VCPURegBatch", wordsize * 16, wordsize),
             Type("seL4_VCPUReg", wordsize, wordsize),
         ] + arm_smmu,
 
@@ -310,6 +312,7 @@ def init_arch_types(wordsize, args):
             CapType("seL4_ARM_IOSpace", wordsize),
             CapType("seL4_ARM_IOPageTable", wordsize),
             StructType("seL4_UserContext", wordsize * 19, wordsize),
+            StructType("seL4_ARM_VCPURegBatch", wordsize * 16, wordsize),
             Type("seL4_VCPUReg", wordsize, wordsize),
         ] + arm_smmu,
 
@@ -330,6 +333,7 @@ def init_arch_types(wordsize, args):
             CapType("seL4_X86_EPTPD", wordsize),
             CapType("seL4_X86_EPTPT", wordsize),
             StructType("seL4_VCPUContext", wordsize * 7, wordsize),
+            StructType("seL4_X86_VMCSBatch", wordsize * 16, wordsize),
             StructType("seL4_UserContext", wordsize * 12, wordsize),
         ],
 
@@ -353,6 +357,7 @@ def init_arch_types(wordsize, args):
             CapType("seL4_X86_EPTPT", wordsize),
             # VCPU size needs to be configuration dependent.
             StructType("seL4_VCPUContext", wordsize * (15 if args.x86_vtx_64bit else 7), wordsize),
+            StructType("seL4_X86_VMCSBatch", wordsize * 16, wordsize),
             StructType("seL4_UserContext", wordsize * 20, wordsize),
         ],
         "riscv32": [
@@ -193,6 +193,12 @@ exception_t handleUnknownSyscall(word_t w)
         return handle_SysBenchmarkGetThreadUtilisation();
     case SysBenchmarkResetThreadUtilisation:
         return handle_SysBenchmarkResetThreadUtilisation();
+    case SysBenchmarkGetDomainUtilisation:
+        return handle_SysBenchmarkGetDomainUtilisation();
+#ifdef CONFIG_KERNEL_MCS
+    case SysBenchmarkGetSchedContextUtilisation:
+        return handle_SysBenchmarkGetSchedContextUtilisation();
+#endif
 #ifdef CONFIG_DEBUG_BUILD
     case SysBenchmarkDumpAllThreadsUtilisation:
         return handle_SysBenchmarkDumpAllThreadsUtilisation();
@@ -200,6 +206,18 @@ exception_t handleUnknownSyscall(word_t w)
         return handle_SysBenchmarkResetAllThreadsUtilisation();
 #endif /* CONFIG_DEBUG_BUILD */
 #endif /* CONFIG_BENCHMARK_TRACK_UTILISATION */
+#ifdef CONFIG_BENCHMARK_FASTPATH_COUNTERS
+    case SysBenchmarkGetFastpathCounters:
+        return handle_SysBenchmarkGetFastpathCounters();
+    case SysBenchmarkResetFastpathCounters:
+        return handle_SysBenchmarkResetFastpathCounters();
+#endif /* CONFIG_BENCHMARK_FASTPATH_COUNTERS */
+#ifdef CONFIG_BENCHMARK_PREEMPTION_LATENCY
+    case SysBenchmarkGetPreemptionCounters:
+        return handle_SysBenchmarkGetPreemptionCounters();
+    case SysBenchmarkResetPreemptionCounters:
+        return handle_SysBenchmarkResetPreemptionCounters();
+#endif /* CONFIG_BENCHMARK_PREEMPTION_LATENCY */
     case SysBenchmarkNullSyscall:
         return EXCEPTION_NONE;
     default:
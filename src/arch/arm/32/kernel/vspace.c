@@ -16,6 +16,7 @@
 #include <machine/io.h>
 #include <machine/debug.h>
 #include <model/statedata.h>
+#include <benchmark/benchmark_preemption.h>
 #include <object/cnode.h>
 #include <object/untyped.h>
 #include <arch/api/invocation.h>
@@ -1277,6 +1278,9 @@ exception_t handleVMFault(tcb_t *thread, vm_fault_type_t vm_faultType)
 
 void deleteASIDPool(asid_t asid_base, asid_pool_t *pool)
 {
+#ifdef CONFIG_BENCHMARK_PREEMPTION_LATENCY
+    word_t prev_op = benchmark_preemption_op(BENCHMARK_PREEMPTION_OP_DELETE_ASID_POOL);
+#endif
     unsigned int offset;
 
     /* Haskell error: "ASID pool's base must be aligned" */
@@ -1292,6 +1296,9 @@ void deleteASIDPool(asid_t asid_base, asid_pool_t *pool)
         armKSASIDTable[asid_base >> asidLowBits] = NULL;
         setVMRoot(NODE_STATE(ksCurThread));
     }
+#ifdef CONFIG_BENCHMARK_PREEMPTION_LATENCY
+    benchmark_preemption_op(prev_op);
+#endif
 }
 
 void deleteASID(asid_t asid, pde_t *pd)
@@ -7,6 +7,7 @@
 #include <config.h>
 #include <types.h>
 #include <benchmark/benchmark.h>
+#include <benchmark/benchmark_sample.h>
 #include <api/failures.h>
 #include <api/syscall.h>
 #include <kernel/boot.h>
@@ -16,6 +17,7 @@
 #include <machine/io.h>
 #include <machine/debug.h>
 #include <model/statedata.h>
+#include <benchmark/benchmark_preemption.h>
 #include <object/cnode.h>
 #include <object/untyped.h>
 #include <arch/api/invocation.h>
@@ -854,9 +856,96 @@ static void storeHWASID(asid_t asid, hw_asid_t hw_asid)
     asid_map = asid_map_asid_map_vspace_set_stored_vmid_valid(asid_map, true);
 
     setASIDMap(poolPtr, asid, asid_map);
+#ifndef CONFIG_ARM_HYP_VMID_ROLLOVER
     armKSHWASIDTable[hw_asid] = asid;
+#endif
+}
+
+#ifdef CONFIG_ARM_HYP_VMID_ROLLOVER
+static bool_t isReservedHWASID(hw_asid_t hw_asid)
+{
+    word_t i;
+
+    for (i = 0; i < CONFIG_MAX_NUM_NODES; i++) {
+        if (armKSReservedHWASIDs[i] == hw_asid) {
+            return true;
+        }
+    }
+    return false;
+}
+
+/* The VMID of the address space of the thread running on a core, or zero if
+ * that thread has no address space with a valid VMID. */
+static hw_asid_t activeHWASID(word_t core)
+{
+    tcb_t *tcb = NODE_STATE_ON_CORE(ksCurThread, core);
+    cap_t threadRoot;
+    asid_map_t asid_map;
+
+    if (tcb == NULL) {
+        return 0;
+    }
+
+    threadRoot = TCB_PTR_CTE_PTR(tcb, tcbVTable)->cap;
+    if (!isValidNativeRoot(threadRoot)) {
+        return 0;
+    }
+
+    asid_map = findMapForASID(cap_vspace_cap_get_capVSMappedASID(threadRoot));
+    if (asid_map_get_type(asid_map) != asid_map_asid_map_vspace ||
+        !asid_map_asid_map_vspace_get_stored_vmid_valid(asid_map)) {
+        return 0;
+    }
+    return asid_map_asid_map_vspace_get_stored_hw_vmid(asid_map);
+}
+
+/* Start a new VMID generation. The VMIDs of the address spaces running on any
+ * core are kept and excluded from allocation, all others are dropped and the
+ * TLBs are flushed once for all of them. */
+static void rolloverHWASIDs(void)
+{
+    word_t i, j;
+
+    for (i = 0; i < CONFIG_MAX_NUM_NODES; i++) {
+        armKSReservedHWASIDs[i] = activeHWASID(i);
+    }
+
+    for (i = 0; i < nASIDPools; i++) {
+        asid_pool_t *poolPtr = armKSASIDTable[i];
+        if (poolPtr == NULL) {
+            continue;
+        }
+        for (j = 0; j < BIT(asidLowBits); j++) {
+            asid_map_t *asid_map = &poolPtr->array[j];
+            if (asid_map_ptr_get_type(asid_map) == asid_map_asid_map_vspace &&
+                asid_map_asid_map_vspace_ptr_get_stored_vmid_valid(asid_map) &&
+                !isReservedHWASID(asid_map_asid_map_vspace_ptr_get_stored_hw_vmid(asid_map))) {
+                asid_map_asid_map_vspace_ptr_set_stored_hw_vmid(asid_map, 0);
+                asid_map_asid_map_vspace_ptr_set_stored_vmid_valid(asid_map, false);
+            }
+        }
+    }
+
+    invalidateTranslationAll();
+    armKSNextASID = 1;
 }
 
+static hw_asid_t findFreeHWASID(void)
+{
+    hw_asid_t hw_asid;
+
+    /* VMID 0 is never handed out, so armKSNextASID wrapping to 0 marks the
+     * end of a generation. This includes the very first allocation. */
+    do {
+        if (armKSNextASID == 0) {
+            rolloverHWASIDs();
+        }
+        hw_asid = armKSNextASID++;
+    } while (isReservedHWASID(hw_asid));
+
+    return hw_asid;
+}
+#else
 static hw_asid_t findFreeHWASID(void)
 {
     word_t hw_asid_offset;
@@ -886,6 +975,7 @@ static hw_asid_t findFreeHWASID(void)
 
     return hw_asid;
 }
+#endif /* CONFIG_ARM_HYP_VMID_ROLLOVER */
 
 hw_asid_t getHWASID(asid_t asid)
 {
@@ -905,6 +995,7 @@ hw_asid_t getHWASID(asid_t asid)
 
 static void invalidateASIDEntry(asid_t asid)
 {
+#ifndef CONFIG_ARM_HYP_VMID_ROLLOVER
     asid_map_t asid_map;
 
     asid_map = findMapForASID(asid);
@@ -912,6 +1003,7 @@ static void invalidateASIDEntry(asid_t asid)
         armKSHWASIDTable[asid_map_asid_map_vspace_get_stored_hw_vmid(asid_map)] =
             asidInvalid;
     }
+#endif
     invalidateASID(asid);
 }
 
@@ -958,14 +1050,8 @@ void decreaseASIDBindCB(asid_t asid)
 }
 #endif
 
-static inline void invalidateTLBByASID(asid_t asid)
+static inline void invalidateCPUTLBByASID(asid_t asid)
 {
-#ifdef CONFIG_ARM_SMMU
-    word_t bind_cb = getASIDBindCB(asid);
-    if (unlikely(bind_cb)) {
-        invalidateSMMUTLBByASID(asid, bind_cb);
-    }
-#endif
 #ifdef CONFIG_ARM_HYPERVISOR_SUPPORT
     asid_map_t asid_map;
 
@@ -979,6 +1065,32 @@ static inline void invalidateTLBByASID(asid_t asid)
 #endif
 }
 
+static inline void invalidateTLBByASID(asid_t asid)
+{
+#ifdef CONFIG_ARM_SMMU
+    word_t bind_cb = getASIDBindCB(asid);
+    if (unlikely(bind_cb)) {
+        invalidateSMMUTLBByASID(asid, bind_cb);
+    }
+#endif
+    invalidateCPUTLBByASID(asid);
+}
+
+#ifdef CONFIG_FRAME_MAP_RANGE
+/* Invalidate npages leaf mappings of size BIT(pageBits) starting at vaddr. The
+ * SMMU invalidates only the range, the CPU TLB is invalidated by ASID. */
+static inline void invalidateTLBByASIDRange(asid_t asid, vptr_t vaddr, word_t npages, word_t pageBits)
+{
+#ifdef CONFIG_ARM_SMMU
+    word_t bind_cb = getASIDBindCB(asid);
+    if (unlikely(bind_cb)) {
+        invalidateSMMUTLBByASIDRange(asid, vaddr, npages, pageBits, bind_cb);
+    }
+#endif
+    invalidateCPUTLBByASID(asid);
+}
+#endif
+
 static inline void invalidateTLBByASIDVA(asid_t asid, vptr_t vaddr)
 {
 #ifdef CONFIG_ARM_SMMU
@@ -1088,6 +1200,9 @@ void deleteASID(asid_t asid, vspace_root_t *vspace)
 
 void deleteASIDPool(asid_t asid_base, asid_pool_t *pool)
 {
+#ifdef CONFIG_BENCHMARK_PREEMPTION_LATENCY
+    word_t prev_op = benchmark_preemption_op(BENCHMARK_PREEMPTION_OP_DELETE_ASID_POOL);
+#endif
     word_t offset;
 
     assert((asid_base & MASK(asidLowBits)) == 0);
@@ -1105,6 +1220,9 @@ void deleteASIDPool(asid_t asid_base, asid_pool_t *pool)
         armKSASIDTable[asid_base >> asidLowBits] = NULL;
         setVMRoot(NODE_STATE(ksCurThread));
     }
+#ifdef CONFIG_BENCHMARK_PREEMPTION_LATENCY
+    benchmark_preemption_op(prev_op);
+#endif
 }
 
 static void doFlush(word_t invLabel, vptr_t start, vptr_t end, paddr_t pstart)
@@ -1170,6 +1288,65 @@ static exception_t performVSpaceFlush(word_t invLabel, vspace_root_t *vspaceRoot
     return EXCEPTION_NONE;
 }
 
+#ifdef CONFIG_FRAME_MAP_RANGE
+static inline void cleanPTERange(pte_t *start, pte_t *end)
+{
+    if (start < end) {
+        cleanCacheRange_PoU((vptr_t)start, (vptr_t)end - 1, pptr_to_paddr(start));
+    }
+}
+
+static exception_t performVSpaceMapRange(asid_t asid, vspace_root_t *vspaceRoot, cte_t *window,
+                                         word_t numFrames, vm_page_size_t frameSize, vptr_t vaddr,
+                                         seL4_CapRights_t rights, vm_attributes_t attributes)
+{
+    word_t flushStart = numFrames;
+    word_t flushEnd = 0;
+    pte_t *runStart = NULL;
+    pte_t *ptSlot = NULL;
+    word_t pageBits = pageBitsForSize(frameSize);
+    word_t i;
+
+    for (i = 0; i < numFrames; i++) {
+        vptr_t va = vaddr + (i << pageBits);
+        cap_t cap = window[i].cap;
+        vm_rights_t vmRights;
+        paddr_t base;
+
+        /* Only walk the page tables when entering a new table at the level
+         * of the frames; the translation cache maintenance is deferred to the
+         * end of each run. */
+        if (i == 0 || IS_ALIGNED(va, PT_INDEX_BITS + pageBits)) {
+            cleanPTERange(runStart, ptSlot);
+            ptSlot = lookupPTSlot(vspaceRoot, va).ptSlot;
+            runStart = ptSlot;
+        }
+
+        vmRights = maskVMRights(cap_frame_cap_get_capFVMRights(cap), rights);
+        base = pptr_to_paddr((void *)cap_frame_cap_get_capFBasePtr(cap));
+
+        cap = cap_frame_cap_set_capFMappedASID(cap, asid);
+        cap = cap_frame_cap_set_capFMappedAddress(cap, va);
+        window[i].cap = cap;
+
+        if (pte_ptr_get_valid(ptSlot)) {
+            flushStart = MIN(flushStart, i);
+            flushEnd = i + 1;
+        }
+        *ptSlot = makeUserPagePTE(base, vmRights, attributes, frameSize);
+        ptSlot++;
+    }
+    cleanPTERange(runStart, ptSlot);
+
+    if (unlikely(flushStart < flushEnd)) {
+        assert(asid < BIT(16));
+        invalidateTLBByASIDRange(asid, vaddr + (flushStart << pageBits), flushEnd - flushStart, pageBits);
+    }
+
+    return EXCEPTION_NONE;
+}
+#endif /* CONFIG_FRAME_MAP_RANGE */
+
 
 static exception_t performPageTableInvocationMap(cap_t cap, cte_t *ctSlot, pte_t pte, pte_t *ptSlot)
 {
@@ -1404,6 +1581,134 @@ static exception_t decodeARMVSpaceRootInvocation(word_t invLabel, word_t length,
         setThreadState(NODE_STATE(ksCurThread), ThreadState_Restart);
         return performVSpaceFlush(invLabel, vspaceRoot, asid, start, end - 1, pstart);
 
+#ifdef CONFIG_FRAME_MAP_RANGE
+    case ARMVSpaceMapRange: {
+        word_t nodeDepth, nodeOffset, numFrames, pageBits, i;
+        vm_page_size_t frameSize;
+        cptr_t nodeIndex;
+        vptr_t vaddr;
+        seL4_CapRights_t rights;
+        vm_attributes_t attributes;
+        lookupSlotWindow_ret_t window_ret;
+        lookupPTSlot_ret_t lu_ret;
+
+        if (unlikely(length < 7 || current_extra_caps.excaprefs[0] == NULL)) {
+            userError("VSpaceRoot MapRange: Truncated message.");
+            current_syscall_error.type = seL4_TruncatedMessage;
+            return EXCEPTION_SYSCALL_ERROR;
+        }
+
+        nodeIndex  = getSyscallArg(0, buffer);
+        nodeDepth  = getSyscallArg(1, buffer);
+        nodeOffset = getSyscallArg(2, buffer);
+        numFrames  = getSyscallArg(3, buffer);
+        vaddr      = getSyscallArg(4, buffer);
+        rights     = rightsFromWord(getSyscallArg(5, buffer));
+        attributes = vmAttributesFromWord(getSyscallArg(6, buffer));
+
+        if (unlikely(!isValidNativeRoot(cap))) {
+            current_syscall_error.type = seL4_InvalidCapability;
+            current_syscall_error.invalidCapNumber = 0;
+            return EXCEPTION_SYSCALL_ERROR;
+        }
+
+        vspaceRoot = VSPACE_PTR(cap_vspace_cap_get_capVSBasePtr(cap));
+        asid = cap_vspace_cap_get_capVSMappedASID(cap);
+
+        find_ret = findVSpaceForASID(asid);
+        if (unlikely(find_ret.status != EXCEPTION_NONE)) {
+            userError("VSpaceRoot MapRange: No VSpace for ASID");
+            current_syscall_error.type = seL4_FailedLookup;
+            current_syscall_error.failedLookupWasSource = false;
+            return EXCEPTION_SYSCALL_ERROR;
+        }
+
+        if (unlikely(find_ret.vspace_root != vspaceRoot)) {
+            userError("VSpaceRoot MapRange: Invalid VSpace Cap");
+            current_syscall_error.type = seL4_InvalidCapability;
+            current_syscall_error.invalidCapNumber = 0;
+            return EXCEPTION_SYSCALL_ERROR;
+        }
+
+        window_ret = lookupSourceWindow(current_extra_caps.excaprefs[0]->cap, nodeIndex,
+                                        nodeDepth, nodeOffset, numFrames,
+                                        CONFIG_MAP_RANGE_MAX_FRAMES);
+        if (unlikely(window_ret.status != EXCEPTION_NONE)) {
+            userError("VSpaceRoot MapRange: Invalid frame window.");
+            return window_ret.status;
+        }
+
+        /* All frames have the size of the first one, so that guest RAM can
+         * be mapped with large or huge pages, which are stage-2 block
+         * mappings when the hypervisor support is enabled. */
+        if (unlikely(cap_get_capType(window_ret.window[0].cap) != cap_frame_cap)) {
+            userError("VSpaceRoot MapRange: Slot #%lu is not a frame cap.", (long)nodeOffset);
+            current_syscall_error.type = seL4_InvalidCapability;
+            current_syscall_error.invalidCapNumber = 1;
+            return EXCEPTION_SYSCALL_ERROR;
+        }
+        frameSize = cap_frame_cap_get_capFSize(window_ret.window[0].cap);
+        pageBits = pageBitsForSize(frameSize);
+
+        if (unlikely(!IS_ALIGNED(vaddr, pageBits))) {
+            current_syscall_error.type = seL4_AlignmentError;
+            return EXCEPTION_SYSCALL_ERROR;
+        }
+
+        /* numFrames is bounded by CONFIG_MAP_RANGE_MAX_FRAMES, so the size
+         * of the range cannot overflow. */
+        if (unlikely(vaddr > USER_TOP || (numFrames << pageBits) - 1 > USER_TOP - vaddr)) {
+            userError("VSpaceRoot MapRange: Exceed the user addressable region.");
+            current_syscall_error.type = seL4_InvalidArgument;
+            current_syscall_error.invalidArgumentNumber = 4;
+            return EXCEPTION_SYSCALL_ERROR;
+        }
+
+        for (i = 0; i < numFrames; i++) {
+            cap_t frameCap = window_ret.window[i].cap;
+            vptr_t va = vaddr + (i << pageBits);
+            asid_t frame_asid;
+
+            if (unlikely(cap_get_capType(frameCap) != cap_frame_cap ||
+                         cap_frame_cap_get_capFSize(frameCap) != frameSize)) {
+                userError("VSpaceRoot MapRange: Slot #%lu is not a frame cap of the size of the first one.",
+                          (long)(nodeOffset + i));
+                current_syscall_error.type = seL4_InvalidCapability;
+                current_syscall_error.invalidCapNumber = 1;
+                return EXCEPTION_SYSCALL_ERROR;
+            }
+
+            /* In the case of remap, the cap should already be mapped here */
+            frame_asid = cap_frame_cap_get_capFMappedASID(frameCap);
+            if (frame_asid != asidInvalid &&
+                (frame_asid != asid || cap_frame_cap_get_capFMappedAddress(frameCap) != va)) {
+                userError("VSpaceRoot MapRange: Frame in slot #%lu is mapped elsewhere.",
+                          (long)(nodeOffset + i));
+                current_syscall_error.type = seL4_InvalidArgument;
+                current_syscall_error.invalidArgumentNumber = 4;
+                return EXCEPTION_SYSCALL_ERROR;
+            }
+
+            /* Slots above the last level may hold a page table instead, which
+             * must not be replaced by a block mapping, so large and huge
+             * frames are looked up one by one like in ARMPageMap. */
+            if (frameSize != ARMSmallPage || i == 0 || IS_ALIGNED(va, PT_INDEX_BITS + pageBits)) {
+                lu_ret = lookupPTSlot(vspaceRoot, va);
+                if (unlikely(lu_ret.ptBitsLeft != pageBits)) {
+                    current_lookup_fault = lookup_fault_missing_capability_new(lu_ret.ptBitsLeft);
+                    current_syscall_error.type = seL4_FailedLookup;
+                    current_syscall_error.failedLookupWasSource = false;
+                    return EXCEPTION_SYSCALL_ERROR;
+                }
+            }
+        }
+
+        setThreadState(NODE_STATE(ksCurThread), ThreadState_Restart);
+        return performVSpaceMapRange(asid, vspaceRoot, window_ret.window, numFrames, frameSize,
+                                     vaddr, rights, attributes);
+    }
+#endif /* CONFIG_FRAME_MAP_RANGE */
+
     default:
         current_syscall_error.type = seL4_IllegalOperation;
         return EXCEPTION_SYSCALL_ERROR;
@@ -1874,7 +2179,7 @@ void kernelDataAbort(word_t pc)
 }
 #endif /* CONFIG_DEBUG_BUILD */
 
-#ifdef CONFIG_PRINTING
+#if defined(CONFIG_PRINTING) || CONFIG_BENCHMARK_SAMPLE_PROFILE_USER_FRAMES > 0
 typedef struct readWordFromVSpace_ret {
     exception_t status;
     word_t value;
@@ -1896,6 +2201,12 @@ static readWordFromVSpace_ret_t readWordFromVSpace(vspace_root_t *pd, word_t vad
         return ret;
     }
 
+    /* Device frames may lie outside the kernel window */
+    if (pte_page_ptr_get_page_base_address(lookup_ret.ptSlot) >= PADDR_TOP) {
+        ret.status = EXCEPTION_LOOKUP_FAULT;
+        return ret;
+    }
+
     offset = vaddr & MASK(lookup_ret.ptBitsLeft);
     kernel_vaddr = (word_t)paddr_to_pptr(pte_page_ptr_get_page_base_address(lookup_ret.ptSlot));
     value = (word_t *)(kernel_vaddr + offset);
@@ -1904,7 +2215,51 @@ static readWordFromVSpace_ret_t readWordFromVSpace(vspace_root_t *pd, word_t vad
     ret.value = *value;
     return ret;
 }
+#endif /* CONFIG_PRINTING || CONFIG_BENCHMARK_SAMPLE_PROFILE_USER_FRAMES > 0 */
 
+#if CONFIG_BENCHMARK_SAMPLE_PROFILE_USER_FRAMES > 0
+void benchmark_arch_sample_user_frames(tcb_t *tptr, word_t *frames)
+{
+    cap_t threadRoot;
+    vspace_root_t *vspaceRoot;
+    readWordFromVSpace_ret_t next, lr;
+    word_t fp;
+
+#ifdef CONFIG_ARM_HYPERVISOR_SUPPORT
+    /* The registers of a thread running a guest are not user-level registers */
+    if (tptr->tcbArch.tcbVCPU) {
+        return;
+    }
+#endif
+
+    threadRoot = TCB_PTR_CTE_PTR(tptr, tcbVTable)->cap;
+    if (cap_get_capType(threadRoot) != cap_vspace_cap) {
+        return;
+    }
+    vspaceRoot = VSPACE_PTR(cap_vspace_cap_get_capVSBasePtr(threadRoot));
+
+    /* Each frame record holds the previous frame pointer followed by the
+     * return address, and records further up the stack have higher addresses */
+    fp = getRegister(tptr, X29);
+    for (unsigned int i = 0; i < CONFIG_BENCHMARK_SAMPLE_PROFILE_USER_FRAMES; i++) {
+        if (fp == 0 || !IS_ALIGNED(fp, seL4_WordSizeBits + 1) || fp >= USER_TOP) {
+            return;
+        }
+        next = readWordFromVSpace(vspaceRoot, fp);
+        lr = readWordFromVSpace(vspaceRoot, fp + sizeof(word_t));
+        if (next.status != EXCEPTION_NONE || lr.status != EXCEPTION_NONE) {
+            return;
+        }
+        frames[i] = lr.value;
+        if (next.value <= fp) {
+            return;
+        }
+        fp = next.value;
+    }
+}
+#endif /* CONFIG_BENCHMARK_SAMPLE_PROFILE_USER_FRAMES > 0 */
+
+#ifdef CONFIG_PRINTING
 void Arch_userStackTrace(tcb_t *tptr)
 {
     cap_t threadRoot;
@@ -100,7 +100,16 @@ compile_assert(log_pde_is_correct_preallocated_pde,
 #ifdef CONFIG_ARM_HYPERVISOR_SUPPORT
 UP_STATE_DEFINE(vcpu_t, *armHSCurVCPU);
 UP_STATE_DEFINE(bool_t, armHSVCPUActive);
+UP_STATE_DEFINE(uint64_t, armHSVGICLRDirty);
 
+#ifdef CONFIG_ARM_HYP_VMID_ROLLOVER
+/* The next VMID to hand out in the current generation. Zero means that the
+ * current generation is exhausted and a rollover is due. */
+hw_asid_t armKSNextASID;
+/* VMIDs that were in use by a core when the current generation started and
+ * are therefore excluded from allocation until the next rollover. */
+hw_asid_t armKSReservedHWASIDs[CONFIG_MAX_NUM_NODES];
+#else
 /* The hardware VMID to virtual ASID mapping table.
  * The ARMv8 supports 8-bit VMID which is used as logical ASID
  * when the kernel runs in EL2.
@@ -108,6 +117,7 @@ UP_STATE_DEFINE(bool_t, armHSVCPUActive);
 asid_t armKSHWASIDTable[BIT(hwASIDBits)];
 hw_asid_t armKSNextASID;
 #endif
+#endif
 
 #ifdef CONFIG_ARM_SMMU
 /*recording the state of created SID caps*/
@@ -6,13 +6,12 @@
 
 #include <benchmark/benchmark.h>
 #include <arch/benchmark.h>
+#include <benchmark/benchmark_sample.h>
 
 #if CONFIG_MAX_NUM_TRACE_POINTS > 0
 timestamp_t ksEntries[CONFIG_MAX_NUM_TRACE_POINTS];
 bool_t ksStarted[CONFIG_MAX_NUM_TRACE_POINTS];
 timestamp_t ksExit;
-seL4_Word ksLogIndex = 0;
-seL4_Word ksLogIndexFinalized = 0;
 #endif /* CONFIG_MAX_NUM_TRACE_POINTS > 0 */
 
 #ifdef CONFIG_ARM_ENABLE_PMU_OVERFLOW_INTERRUPT
@@ -20,6 +19,12 @@ UP_STATE_DEFINE(uint64_t, ccnt_num_overflows);
 #endif /* CONFIG_ARM_ENABLE_PMU_OVERFLOW_INTERRUPT */
 
 #ifdef CONFIG_ENABLE_BENCHMARKS
+/* PMCR.N, the number of implemented event counters */
+#define PMCR_N_SHIFT 11
+#define PMCR_N_MASK 0x1f
+/* PMXEVTYPER.NSH, count events at EL2 */
+#define PMXEVTYPER_NSH 27
+
 void arm_init_ccnt(void)
 {
 
@@ -35,4 +40,94 @@ void arm_init_ccnt(void)
     armv_enableOverflowIRQ();
 #endif /* CONFIG_ARM_ENABLE_PMU_OVERFLOW_INTERRUPT */
 }
+
+#ifdef CONFIG_BENCHMARK_TRACK_UTILISATION_PMU
+static const word_t benchmark_pmu_events[] = { CONFIG_BENCHMARK_TRACK_UTILISATION_PMU_EVENTS };
+
+/* Program event counter i to count the i-th configured event at all exception
+ * levels the kernel and user level run at. */
+BOOT_CODE bool_t arm_init_pmu_events(void)
+{
+    word_t pmcr, evtype, enable;
+
+    SYSTEM_READ_WORD(PMCR, pmcr);
+    if (((pmcr >> PMCR_N_SHIFT) & PMCR_N_MASK) < BENCHMARK_PMU_NUM_EVENTS) {
+        printf("PMU implements %lu event counters, but %lu events are configured\n",
+               (pmcr >> PMCR_N_SHIFT) & PMCR_N_MASK, (word_t)BENCHMARK_PMU_NUM_EVENTS);
+        return false;
+    }
+
+    for (word_t i = 0; i < BENCHMARK_PMU_NUM_EVENTS; i++) {
+        evtype = benchmark_pmu_events[i];
+#ifdef CONFIG_ARM_HYPERVISOR_SUPPORT
+        evtype |= BIT(PMXEVTYPER_NSH);
+#endif
+        SYSTEM_WRITE_WORD(PMSELR, i);
+        isb();
+        SYSTEM_WRITE_WORD(PMXEVTYPER, evtype);
+    }
+
+    SYSTEM_READ_WORD(PMCNTENSET, enable);
+    enable |= MASK(BENCHMARK_PMU_NUM_EVENTS);
+    SYSTEM_WRITE_WORD(PMCNTENSET, enable);
+
+    return true;
+}
+#endif /* CONFIG_BENCHMARK_TRACK_UTILISATION_PMU */
+
+#ifdef CONFIG_BENCHMARK_SAMPLE_PROFILE
+/* Event counter 0 counts CPU cycles and overflows after every sampling period */
+#define SAMPLE_COUNTER 0
+#define PMU_EVENT_CPU_CYCLES 0x11
+#define SAMPLE_COUNTER_START ((word_t)(UINT32_MAX - CONFIG_BENCHMARK_SAMPLE_PROFILE_PERIOD + 1))
+
+compile_assert(sample_profile_period_sane,
+               CONFIG_BENCHMARK_SAMPLE_PROFILE_PERIOD > 0 && CONFIG_BENCHMARK_SAMPLE_PROFILE_PERIOD < BIT(31))
+
+static inline void arm_start_sample_period(void)
+{
+    SYSTEM_WRITE_WORD(PMSELR, SAMPLE_COUNTER);
+    isb();
+    SYSTEM_WRITE_WORD(PMXEVCNTR, SAMPLE_COUNTER_START);
+}
+
+BOOT_CODE bool_t arm_init_pmu_sampling(void)
+{
+    word_t pmcr, val;
+
+    SYSTEM_READ_WORD(PMCR, pmcr);
+    if (((pmcr >> PMCR_N_SHIFT) & PMCR_N_MASK) == 0) {
+        printf("PMU implements no event counters, sampling is not possible\n");
+        return false;
+    }
+
+    val = PMU_EVENT_CPU_CYCLES;
+#ifdef CONFIG_ARM_HYPERVISOR_SUPPORT
+    val |= BIT(PMXEVTYPER_NSH);
+#endif
+    SYSTEM_WRITE_WORD(PMSELR, SAMPLE_COUNTER);
+    isb();
+    SYSTEM_WRITE_WORD(PMXEVTYPER, val);
+    arm_start_sample_period();
+
+    SYSTEM_READ_WORD(PMINTENSET, val);
+    val |= BIT(SAMPLE_COUNTER);
+    SYSTEM_WRITE_WORD(PMINTENSET, val);
+
+    SYSTEM_READ_WORD(PMCNTENSET, val);
+    val |= BIT(SAMPLE_COUNTER);
+    SYSTEM_WRITE_WORD(PMCNTENSET, val);
+
+    return true;
+}
+
+void arm_handle_sample_overflow(void)
+{
+    word_t val = BIT(SAMPLE_COUNTER);
+
+    SYSTEM_WRITE_WORD(PMOVSR, val);
+    benchmark_sample_record();
+    arm_start_sample_period();
+}
+#endif /* CONFIG_BENCHMARK_SAMPLE_PROFILE */
 #endif
@@ -16,6 +16,9 @@
 #include <benchmark/benchmark_track.h>
 #include <benchmark/benchmark_utilisation.h>
 #include <arch/machine.h>
+#ifdef CONFIG_ARM_SMMU
+#include <drivers/smmu/smmuv2.h>
+#endif
 
 void VISIBLE NORETURN c_handle_undefined_instruction(void)
 {
@@ -143,6 +146,12 @@ void NORETURN slowpath(syscall_t syscall)
         handleSyscall(syscall);
     }
 
+#ifdef CONFIG_ARM_SMMU_DEFER_TLB_SYNC
+    /* SMMU TLB invalidations issued by this syscall must complete before the
+     * kernel lock is released and user level can reuse the unmapped memory */
+    smmu_tlb_sync_deferred();
+#endif
+
     restore_user_context();
     UNREACHABLE();
 }
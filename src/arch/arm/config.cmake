@@ -91,6 +91,70 @@ config_option(
 
 config_option(KernelArmGicV3 ARM_GIC_V3_SUPPORT "Build support for GICv3" DEFAULT OFF)
 
+config_option(
+    KernelArmHypVMIDRollover ARM_HYP_VMID_ROLLOVER
+    "Allocate hardware VMIDs in generations. VMIDs are handed out sequentially \
+    and, once they are exhausted, all of them are reclaimed with a single \
+    TLB invalidation instead of evicting one VMID with its own TLB \
+    invalidation on every allocation."
+    DEFAULT OFF
+    DEPENDS "KernelArmHypervisorSupport;KernelSel4ArchAarch64;NOT KernelVerificationBuild"
+    DEFAULT_DISABLED OFF
+)
+
+config_option(
+    KernelArmHypVMID16Bit ARM_HYP_VMID_16BIT
+    "Use 16-bit VMIDs. Requires a processor implementing ARMv8.1 VMID16 and \
+    fails to boot otherwise."
+    DEFAULT OFF
+    DEPENDS "KernelArmHypVMIDRollover"
+    DEFAULT_DISABLED OFF
+)
+
+config_option(
+    KernelArmHypVIRQQueue ARM_HYP_VIRQ_QUEUE
+    "Provide the VCPU QueueIRQ invocation. Virtual interrupts are written to \
+    any free VGIC list register, and queued in the VCPU when all list \
+    registers are in use. The kernel moves queued interrupts into list \
+    registers as they become free, without involving user level."
+    DEFAULT OFF
+    DEPENDS "KernelArmHypervisorSupport;NOT KernelVerificationBuild"
+    DEFAULT_DISABLED OFF
+)
+
+config_string(
+    KernelArmHypVIRQQueueSize ARM_HYP_VIRQ_QUEUE_SIZE
+    "Number of virtual interrupts that can be queued in each VCPU while all \
+    VGIC list registers are in use."
+    DEFAULT 32
+    UNQUOTE
+    DEPENDS "KernelArmHypVIRQQueue"
+    UNDEF_DISABLED
+)
+
+config_option(
+    KernelArmHypVPPIInject ARM_HYP_VPPI_INJECT
+    "Provide the VCPU SetVPPIInjection invocation. A VCPU configured with it \
+    has virtual PPI events, such as the virtual timer, injected into a free \
+    VGIC list register by the kernel, and the PPI unmasked again when the \
+    guest completes it. A VPPIEvent fault is only raised when no list \
+    register is free."
+    DEFAULT OFF
+    DEPENDS "KernelArmHypervisorSupport;NOT KernelVerificationBuild"
+    DEFAULT_DISABLED OFF
+)
+
+config_option(
+    KernelArmHypVIRQAsync ARM_HYP_VIRQ_ASYNC
+    "On SMP, inject virtual interrupts into a VCPU that is loaded on another \
+    core without a blocking remote call. The interrupt is recorded in the \
+    VCPU and the other core is sent a reschedule IPI at the end of the \
+    kernel entry, on which it writes the interrupt to its list registers."
+    DEFAULT OFF
+    DEPENDS "KernelArmHypervisorSupport;NOT KernelVerificationBuild"
+    DEFAULT_DISABLED OFF
+)
+
 if(KernelArmPASizeBits40 AND ARM_HYPERVISOR_SUPPORT)
     config_set(KernelAarch64VspaceS2StartL1 AARCH64_VSPACE_S2_START_L1 "ON")
 else()
@@ -137,6 +201,26 @@ config_option(
     DEFAULT_DISABLED OFF
 )
 
+config_string(
+    KernelArmSMMUTLBIRangeMax ARM_SMMU_TLBI_RANGE_MAX
+    "Largest number of pages for which a context bank TLB invalidation of an address range \
+    is done page by page. Larger ranges invalidate the whole ASID (VMID with hypervisor \
+    support) of the context bank instead."
+    DEFAULT 16
+    DEPENDS "KernelArmSMMU" DEFAULT_DISABLED 0
+    UNQUOTE
+)
+
+config_option(
+    KernelArmSMMUDeferTLBSync ARM_SMMU_DEFER_TLB_SYNC
+    "Defer waiting for SMMU TLB invalidations to complete until the end of the system \
+    call that issued them, so that all invalidations of one system call are synchronised \
+    once per context bank instead of once per invalidation."
+    DEFAULT OFF
+    DEPENDS "KernelArmSMMU;NOT KernelVerificationBuild"
+    DEFAULT_DISABLED OFF
+)
+
 config_option(
     KernelTk1SMMU TK1_SMMU "Enable SystemMMU for the Tegra TK1 SoC"
     DEFAULT OFF
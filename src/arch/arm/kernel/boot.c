@@ -144,6 +144,14 @@ BOOT_CODE static void init_irqs(cap_t root_cnode_cap)
 #endif /* KERNEL_TIMER_IRQ */
 #endif /* CONFIG_ARM_ENABLE_PMU_OVERFLOW_INTERRUPT */
 
+#ifdef CONFIG_BENCHMARK_SAMPLE_PROFILE
+#ifdef KERNEL_PMU_IRQ
+    setIRQState(IRQReserved, CORE_IRQ_TO_IRQT(0, KERNEL_PMU_IRQ));
+#else
+#error "This platform doesn't support the sample_profile benchmark mode"
+#endif /* KERNEL_PMU_IRQ */
+#endif /* CONFIG_BENCHMARK_SAMPLE_PROFILE */
+
 #ifdef ENABLE_SMP_SUPPORT
     setIRQState(IRQIPI, CORE_IRQ_TO_IRQT(getCurrentCPUIndex(), irq_remote_call_ipi));
     setIRQState(IRQIPI, CORE_IRQ_TO_IRQT(getCurrentCPUIndex(), irq_reschedule_ipi));
@@ -240,6 +248,16 @@ BOOT_CODE static bool_t init_cpu(void)
 #ifdef CONFIG_ENABLE_BENCHMARKS
     arm_init_ccnt();
 #endif /* CONFIG_ENABLE_BENCHMARKS */
+#ifdef CONFIG_BENCHMARK_TRACK_UTILISATION_PMU
+    if (!arm_init_pmu_events()) {
+        return false;
+    }
+#endif /* CONFIG_BENCHMARK_TRACK_UTILISATION_PMU */
+#ifdef CONFIG_BENCHMARK_SAMPLE_PROFILE
+    if (!arm_init_pmu_sampling()) {
+        return false;
+    }
+#endif /* CONFIG_BENCHMARK_SAMPLE_PROFILE */
 
     /* Export selected CPU features for access by PL0 */
     armv_init_user_access();
@@ -280,6 +298,10 @@ BOOT_CODE static bool_t try_init_kernel_secondary_core(void)
     setIRQState(IRQReserved, CORE_IRQ_TO_IRQT(getCurrentCPUIndex(), INTERRUPT_VGIC_MAINTENANCE));
     setIRQState(IRQReserved, CORE_IRQ_TO_IRQT(getCurrentCPUIndex(), INTERRUPT_VTIMER_EVENT));
 #endif /* CONFIG_ARM_HYPERVISOR_SUPPORT */
+#if defined(CONFIG_BENCHMARK_SAMPLE_PROFILE) && KERNEL_PMU_IRQ < NUM_PPI
+    /* A per-core PMU interrupt samples this core as well */
+    setIRQState(IRQReserved, CORE_IRQ_TO_IRQT(getCurrentCPUIndex(), KERNEL_PMU_IRQ));
+#endif /* CONFIG_BENCHMARK_SAMPLE_PROFILE */
     NODE_LOCK_SYS;
 
     clock_sync_test();
@@ -408,5 +408,16 @@ void invalidateSMMUTLBByASIDVA(asid_t asid, vptr_t vaddr, word_t bind_cb)
     }
 }
 
+void invalidateSMMUTLBByASIDRange(asid_t asid, vptr_t vaddr, word_t npages, word_t pageBits, word_t bind_cb)
+{
+    /* Implemeneted in the same way as invalidateSMMUTLBByASID */
+    for (int cb = 0; cb < SMMU_MAX_CB && bind_cb; cb++) {
+        if (unlikely(smmuStateCBAsidTable[cb] == asid)) {
+            smmu_tlb_invalidate_cb_range(cb, asid, vaddr, npages, pageBits);
+            bind_cb--;
+        }
+    }
+}
+
 #endif
 
@@ -15,14 +15,249 @@
 #include <drivers/timer/arm_generic.h>
 #include <plat/platform_gen.h> /* Ensure correct GIC header is included */
 
+/* An empty list register, as written to list registers that are not live */
+static const virq_t virq_empty = { { 0 } };
+
+/* Whether a list register needs to be kept across VCPU switches. An invalid
+ * entry that still has EOIIRQEN set is kept, as it is what raises the EOI
+ * maintenance interrupt. */
+static inline bool_t virq_is_live(virq_t virq)
+{
+    return virq_get_virqType(virq) != virq_virq_invalid || virq_virq_invalid_get_virqEOIIRQEN(virq);
+}
+
+/* Whether list register i of the VCPU can be given a new interrupt. The list
+ * registers are in the hardware if the VCPU is loaded, otherwise in vgic.lr. */
+static inline bool_t vcpu_lr_free(vcpu_t *vcpu, word_t i, bool_t loaded)
+{
+    return !(vcpu->vgic.lr_live & (ULL_CONST(1) << i)) || (loaded && !virq_is_live(get_gic_vcpu_ctrl_lr(i)));
+}
+
+#ifdef CONFIG_ARM_HYP_VIRQ_ASYNC
+/* Write the list registers that other cores posted while the VCPU was loaded
+ * on this core to the hardware. This has to happen before the hardware list
+ * registers of the VCPU are read. */
+static void vcpu_merge_posted(vcpu_t *vcpu)
+{
+    uint64_t posted = vcpu->vgic.lr_posted;
+    word_t i;
+
+    while (posted) {
+        i = ctzll(posted);
+        posted &= ~(ULL_CONST(1) << i);
+        set_gic_vcpu_ctrl_lr(i, vcpu->vgic.lr[i]);
+    }
+    vcpu->vgic.lr_posted = 0;
+}
+
+#ifdef ENABLE_SMP_SUPPORT
+/* Whether the VCPU is loaded on the core of its TCB and that is not this core.
+ * The kernel lock keeps the state of the other core stable. */
+static inline bool_t vcpu_loaded_remotely(vcpu_t *vcpu)
+{
+    return vcpu->vcpuTCB != NULL && vcpu->vcpuTCB->tcbAffinity != getCurrentCPUIndex() &&
+           ARCH_NODE_STATE_ON_CORE(armHSCurVCPU, vcpu->vcpuTCB->tcbAffinity) == vcpu;
+}
+
+/* Have the core the VCPU is loaded on pick up the posted changes. The
+ * reschedule IPI is sent without waiting at the end of this kernel entry. */
+static inline void vcpu_kick(vcpu_t *vcpu)
+{
+    ARCH_NODE_STATE(ipiReschedulePending) |= BIT(vcpu->vcpuTCB->tcbAffinity);
+}
+#endif /* ENABLE_SMP_SUPPORT */
+#endif /* CONFIG_ARM_HYP_VIRQ_ASYNC */
+
+#ifdef CONFIG_ARM_HYP_VIRQ_QUEUE
+/* Whether a list register of the VCPU holds vINTID vid as pending or active */
+static bool_t vcpu_virq_in_lr(vcpu_t *vcpu, word_t vid, bool_t loaded)
+{
+    word_t i;
+    virq_t virq;
+
+    for (i = 0; i < gic_vcpu_num_list_regs; i++) {
+        if (!(vcpu->vgic.lr_live & (ULL_CONST(1) << i))) {
+            continue;
+        }
+        virq = loaded ? get_gic_vcpu_ctrl_lr(i) : vcpu->vgic.lr[i];
+        if (virq_get_virqType(virq) != virq_virq_invalid && VGIC_LR_VINTID(virq.words[0]) == vid) {
+            return true;
+        }
+    }
+    return false;
+}
+
+/* Whether vINTID vid is in the queue of the VCPU */
+static bool_t vcpu_virq_queued(vcpu_t *vcpu, word_t vid)
+{
+    struct virqQueue *queue = &vcpu->virqQueue;
+    word_t i;
+
+    for (i = 0; i < queue->count; i++) {
+        if (VGIC_LR_VINTID(queue->virqs[(queue->head + i) % CONFIG_ARM_HYP_VIRQ_QUEUE_SIZE].words[0]) == vid) {
+            return true;
+        }
+    }
+    return false;
+}
+
+/* Queue an interrupt. An interrupt that is already queued is still pending,
+ * so queueing it again has no effect. */
+static void vcpu_virq_queue_add(vcpu_t *vcpu, virq_t virq)
+{
+    struct virqQueue *queue = &vcpu->virqQueue;
+
+    if (vcpu_virq_queued(vcpu, VGIC_LR_VINTID(virq.words[0]))) {
+        return;
+    }
+    assert(queue->count < CONFIG_ARM_HYP_VIRQ_QUEUE_SIZE);
+    queue->virqs[(queue->head + queue->count) % CONFIG_ARM_HYP_VIRQ_QUEUE_SIZE] = virq;
+    queue->count++;
+}
+
+/* Move queued interrupts into the list registers that are free, and return
+ * how many were moved. An interrupt whose vINTID is pending or active in a list
+ * register stays queued until the guest has completed it, as the same vINTID
+ * must not be in two list registers. As long as interrupts remain queued, an
+ * underflow maintenance interrupt is requested, which is raised once at most
+ * one list register is in use. */
+static word_t vcpu_virq_queue_drain(vcpu_t *vcpu, bool_t loaded)
+{
+    struct virqQueue *queue = &vcpu->virqQueue;
+    word_t n = queue->count;
+    word_t moved = 0;
+    word_t i = 0;
+    virq_t virq;
+    uint32_t hcr;
+
+#ifdef CONFIG_ARM_HYP_VIRQ_ASYNC
+    if (loaded) {
+        vcpu_merge_posted(vcpu);
+    }
+#endif
+    /* Take every entry off the head once. Those that cannot be written yet go
+     * back to the tail, which keeps them in order. */
+    for (; n > 0; n--) {
+        virq = queue->virqs[queue->head];
+        queue->head = (queue->head + 1) % CONFIG_ARM_HYP_VIRQ_QUEUE_SIZE;
+        queue->count--;
+        while (i < gic_vcpu_num_list_regs && !vcpu_lr_free(vcpu, i, loaded)) {
+            i++;
+        }
+        if (i == gic_vcpu_num_list_regs || vcpu_virq_in_lr(vcpu, VGIC_LR_VINTID(virq.words[0]), loaded)) {
+            vcpu_virq_queue_add(vcpu, virq);
+            continue;
+        }
+        vcpu->vgic.lr[i] = virq;
+        vcpu->vgic.lr_live |= ULL_CONST(1) << i;
+        if (loaded) {
+            set_gic_vcpu_ctrl_lr(i, virq);
+        }
+        moved++;
+    }
+
+    if (loaded && ARCH_NODE_STATE(armHSVCPUActive)) {
+        hcr = get_gic_vcpu_ctrl_hcr();
+    } else {
+        hcr = vcpu->vgic.hcr;
+    }
+    if (queue->count > 0) {
+        hcr |= VGIC_HCR_UIE;
+    } else {
+        hcr &= ~VGIC_HCR_UIE;
+    }
+    if (loaded && ARCH_NODE_STATE(armHSVCPUActive)) {
+        set_gic_vcpu_ctrl_hcr(hcr);
+    } else {
+        vcpu->vgic.hcr = hcr;
+    }
+    return moved;
+}
+
+static void vcpu_virq_queue_push(vcpu_t *vcpu, virq_t virq)
+{
+    vcpu_virq_queue_add(vcpu, virq);
+    vcpu_virq_queue_drain(vcpu, ARCH_NODE_STATE(armHSCurVCPU) == vcpu);
+}
+#endif /* CONFIG_ARM_HYP_VIRQ_QUEUE */
+
+#ifdef CONFIG_ARM_HYP_VPPI_INJECT
+/* Write the IRQ configured for a VPPI event to a free list register of the
+ * current VCPU. Returns false if the event has to be raised as a fault, as
+ * injection is not enabled or no list register is free. */
+static bool_t vcpu_vppi_inject(vcpu_t *vcpu, VPPIEventIRQ_t vppi)
+{
+    struct vppiInject *inject = &vcpu->vppiInject;
+    word_t i;
+
+    if (virq_get_virqType(inject->virq[vppi]) == virq_virq_invalid) {
+        return false;
+    }
+#ifdef CONFIG_ARM_HYP_VIRQ_ASYNC
+    vcpu_merge_posted(vcpu);
+#endif
+    for (i = 0; i < gic_vcpu_num_list_regs; i++) {
+        if (vcpu_lr_free(vcpu, i, true)) {
+            vcpu->vgic.lr[i] = inject->virq[vppi];
+            vcpu->vgic.lr_live |= ULL_CONST(1) << i;
+            set_gic_vcpu_ctrl_lr(i, inject->virq[vppi]);
+            inject->lr[vppi] = i;
+            inject->in_lr[vppi] = true;
+            return true;
+        }
+    }
+    return false;
+}
+
+/* Called on the EOI maintenance interrupt of list register lr of the current
+ * VCPU. If the list register held an injected VPPI event, the PPI is unmasked
+ * and true returned, as there is nothing to report to user level. */
+static bool_t vcpu_vppi_eoi(vcpu_t *vcpu, word_t lr)
+{
+    irq_t irq = CORE_IRQ_TO_IRQT(CURRENT_CPU_INDEX(), INTERRUPT_VTIMER_EVENT);
+    VPPIEventIRQ_t vppi = irqVPPIEventIndex(irq);
+
+    if (!vcpu->vppiInject.in_lr[vppi] || vcpu->vppiInject.lr[vppi] != lr) {
+        return false;
+    }
+    vcpu->vppiInject.in_lr[vppi] = false;
+    vcpu->vppi_masked[vppi] = false;
+    if (isIRQActive(irq)) {
+        maskInterrupt(false, irq);
+    }
+    return true;
+}
+
+/* A list register holding an injected VPPI event that user level overwrites
+ * no longer completes the event, it then has to be acknowledged with AckVPPI */
+static void vcpu_vppi_lr_overwritten(vcpu_t *vcpu, word_t lr)
+{
+    word_t vppi;
+
+    for (vppi = 0; vppi < n_VPPIEventIRQ; vppi++) {
+        if (vcpu->vppiInject.in_lr[vppi] && vcpu->vppiInject.lr[vppi] == lr) {
+            vcpu->vppiInject.in_lr[vppi] = false;
+        }
+    }
+}
+#endif /* CONFIG_ARM_HYP_VPPI_INJECT */
+
 BOOT_CODE void vcpu_boot_init(void)
 {
+    word_t i;
+
     armv_vcpu_boot_init();
     gic_vcpu_num_list_regs = VGIC_VTR_NLISTREGS(get_gic_vcpu_ctrl_vtr());
     if (gic_vcpu_num_list_regs > GIC_VCPU_MAX_NUM_LR) {
         printf("Warning: VGIC is reporting more list registers than we support. Truncating\n");
         gic_vcpu_num_list_regs = GIC_VCPU_MAX_NUM_LR;
     }
+    /* vcpu_restore only writes the list registers some VCPU has used, so all
+     * of them have to start out empty */
+    for (i = 0; i < gic_vcpu_num_list_regs; i++) {
+        set_gic_vcpu_ctrl_lr(i, virq_empty);
+    }
+    ARCH_NODE_STATE(armHSVGICLRDirty) = 0;
     vcpu_disable(NULL);
     ARCH_NODE_STATE(armHSCurVCPU) = NULL;
     ARCH_NODE_STATE(armHSVCPUActive) = false;
@@ -32,9 +267,12 @@ BOOT_CODE void vcpu_boot_init(void)
 static void vcpu_save(vcpu_t *vcpu, bool_t active)
 {
     word_t i;
-    word_t lr_num;
+    uint64_t live;
 
     assert(vcpu);
+#ifdef CONFIG_ARM_HYP_VIRQ_ASYNC
+    vcpu_merge_posted(vcpu);
+#endif
     dsb();
     /* If we aren't active then this state already got stored when
      * we were disabled */
@@ -43,13 +281,28 @@ static void vcpu_save(vcpu_t *vcpu, bool_t active)
         vcpu->vgic.hcr = get_gic_vcpu_ctrl_hcr();
         save_virt_timer(vcpu);
     }
+#ifdef CONFIG_ARM_HYP_VCPU_RESIDENT
+    if (!active) {
+        /* The timer was left running when the VCPU was disabled */
+        evict_virt_timer(vcpu);
+    }
+#endif
 
     /* Store GIC VCPU control state */
     vcpu->vgic.vmcr = get_gic_vcpu_ctrl_vmcr();
     vcpu->vgic.apr = get_gic_vcpu_ctrl_apr();
-    lr_num = gic_vcpu_num_list_regs;
-    for (i = 0; i < lr_num; i++) {
+    /* Only the live list registers can have changed since they were
+     * restored. Those that the guest has since completed are dropped, but stay
+     * in the hardware until the next VCPU is restored. */
+    ARCH_NODE_STATE(armHSVGICLRDirty) |= vcpu->vgic.lr_live;
+    live = vcpu->vgic.lr_live;
+    while (live) {
+        i = ctzll(live);
+        live &= ~(ULL_CONST(1) << i);
         vcpu->vgic.lr[i] = get_gic_vcpu_ctrl_lr(i);
+        if (!virq_is_live(vcpu->vgic.lr[i])) {
+            vcpu->vgic.lr_live &= ~(ULL_CONST(1) << i);
+        }
     }
     armv_vcpu_save(vcpu, active);
 }
@@ -85,7 +338,7 @@ void vcpu_restore(vcpu_t *vcpu)
 {
     assert(vcpu);
     word_t i;
-    word_t lr_num;
+    uint64_t lrs;
     /* Turn off the VGIC */
     set_gic_vcpu_ctrl_hcr(0);
     isb();
@@ -93,16 +346,36 @@ void vcpu_restore(vcpu_t *vcpu)
     /* Restore GIC VCPU control state */
     set_gic_vcpu_ctrl_vmcr(vcpu->vgic.vmcr);
     set_gic_vcpu_ctrl_apr(vcpu->vgic.apr);
-    lr_num = gic_vcpu_num_list_regs;
-    for (i = 0; i < lr_num; i++) {
-        set_gic_vcpu_ctrl_lr(i, vcpu->vgic.lr[i]);
+#ifdef CONFIG_ARM_HYP_VIRQ_QUEUE
+    vcpu_virq_queue_drain(vcpu, false);
+#endif
+    /* Load the live list registers of this VCPU and empty those still
+     * holding entries of the previous one */
+    lrs = vcpu->vgic.lr_live | ARCH_NODE_STATE(armHSVGICLRDirty);
+    while (lrs) {
+        i = ctzll(lrs);
+        lrs &= ~(ULL_CONST(1) << i);
+        if (vcpu->vgic.lr_live & (ULL_CONST(1) << i)) {
+            set_gic_vcpu_ctrl_lr(i, vcpu->vgic.lr[i]);
+        } else {
+            set_gic_vcpu_ctrl_lr(i, virq_empty);
+        }
     }
+    ARCH_NODE_STATE(armHSVGICLRDirty) = 0;
+#ifdef CONFIG_ARM_HYP_VIRQ_ASYNC
+    /* The posted list registers were loaded from vgic.lr above */
+    vcpu->vgic.lr_posted = 0;
+#endif
 
     /* restore registers */
 #ifdef CONFIG_ARCH_AARCH64
     vcpu_restore_reg_range(vcpu, seL4_VCPUReg_TTBR0, seL4_VCPUReg_SPSR_EL1);
 #else
     vcpu_restore_reg_range(vcpu, seL4_VCPUReg_ACTLR, seL4_VCPUReg_SPSRfiq);
+#endif
+#ifdef CONFIG_ARM_HYP_VCPU_RESIDENT
+    /* vcpu_enable only resumes the timer state left in the hardware */
+    load_virt_timer(vcpu);
 #endif
     vcpu_enable(vcpu);
 }
@@ -127,6 +400,11 @@ void VPPIEvent(irq_t irq)
         maskInterrupt(true, irq);
         assert(irqVPPIEventIndex(irq) != VPPIEventIRQ_invalid);
         ARCH_NODE_STATE(armHSCurVCPU)->vppi_masked[irqVPPIEventIndex(irq)] = true;
+#ifdef CONFIG_ARM_HYP_VPPI_INJECT
+        if (vcpu_vppi_inject(ARCH_NODE_STATE(armHSCurVCPU), irqVPPIEventIndex(irq))) {
+            return;
+        }
+#endif
         current_fault = seL4_Fault_VPPIEvent_new(IRQT_TO_IRQ(irq));
         /* Current VCPU being active should indicate that the current thread
          * is runnable. At present, verification cannot establish this so we
@@ -161,10 +439,29 @@ void VGICMaintenance(void)
         return;
     }
 
+#ifdef CONFIG_ARM_HYP_VIRQ_ASYNC
+    vcpu_merge_posted(ARCH_NODE_STATE(armHSCurVCPU));
+#endif
+
     eisr0 = get_gic_vcpu_ctrl_eisr0();
     eisr1 = get_gic_vcpu_ctrl_eisr1();
     flags = get_gic_vcpu_ctrl_misr();
 
+#ifdef CONFIG_ARM_HYP_VIRQ_QUEUE
+    /* An underflow is only requested to drain the queue, it is not reported
+     * to user level. If nothing could be moved, the list registers in use hold
+     * the queued vINTIDs or, with a single list register, that one is in use.
+     * The underflow condition then still holds and would be raised again
+     * straight away, so it is turned off until the EOI of one of those list
+     * registers drains the queue. */
+    if (!(flags & VGIC_MISR_EOI) && (flags & VGIC_MISR_U)) {
+        if (vcpu_virq_queue_drain(ARCH_NODE_STATE(armHSCurVCPU), true) == 0) {
+            set_gic_vcpu_ctrl_hcr(get_gic_vcpu_ctrl_hcr() & ~VGIC_HCR_UIE);
+        }
+        return;
+    }
+#endif
+
     if (flags & VGIC_MISR_EOI) {
         int irq_idx;
         if (eisr0) {
@@ -198,9 +495,18 @@ void VGICMaintenance(void)
             assert(ARCH_NODE_STATE(armHSCurVCPU) != NULL && ARCH_NODE_STATE(armHSVCPUActive));
             if (ARCH_NODE_STATE(armHSCurVCPU) != NULL && ARCH_NODE_STATE(armHSVCPUActive)) {
                 ARCH_NODE_STATE(armHSCurVCPU)->vgic.lr[irq_idx] = virq;
+                ARCH_NODE_STATE(armHSCurVCPU)->vgic.lr_live |= ULL_CONST(1) << irq_idx;
             } else {
                 /* FIXME This should not happen */
             }
+#ifdef CONFIG_ARM_HYP_VPPI_INJECT
+            if (vcpu_vppi_eoi(ARCH_NODE_STATE(armHSCurVCPU), irq_idx)) {
+#ifdef CONFIG_ARM_HYP_VIRQ_QUEUE
+                vcpu_virq_queue_drain(ARCH_NODE_STATE(armHSCurVCPU), true);
+#endif
+                return;
+            }
+#endif
             current_fault = seL4_Fault_VGICMaintenance_new(irq_idx, 1);
         }
 
@@ -209,6 +515,11 @@ void VGICMaintenance(void)
         current_fault = seL4_Fault_VGICMaintenance_new(0, 0);
     }
 
+#ifdef CONFIG_ARM_HYP_VIRQ_QUEUE
+    /* The list register of the EOI is free now */
+    vcpu_virq_queue_drain(ARCH_NODE_STATE(armHSCurVCPU), true);
+#endif
+
     /* Current VCPU being active should indicate that the current thread
      * is runnable. At present, verification cannot establish this so we
      * perform an extra check. */
@@ -240,7 +551,9 @@ void vcpu_switch(vcpu_t *new)
             ARCH_NODE_STATE(armHSCurVCPU) = new;
             ARCH_NODE_STATE(armHSVCPUActive) = true;
         } else if (unlikely(ARCH_NODE_STATE(armHSVCPUActive))) {
-            /* leave the current VCPU state loaded, but disable vgic and mmu */
+            /* leave the current VCPU state loaded, but disable vgic and mmu.
+             * With CONFIG_ARM_HYP_VCPU_RESIDENT the virtual timer also stays
+             * loaded, with its interrupt masked. */
 #ifdef ARM_HYP_CP14_SAVE_AND_RESTORE_VCPU_THREADS
             saveAllBreakpointState(ARCH_NODE_STATE(armHSCurVCPU)->vcpuTCB);
 #endif
@@ -256,10 +569,20 @@ void vcpu_switch(vcpu_t *new)
 
 static void vcpu_invalidate_active(void)
 {
+#ifdef CONFIG_ARM_HYP_VCPU_RESIDENT
+    if (!ARCH_NODE_STATE(armHSVCPUActive) && ARCH_NODE_STATE(armHSCurVCPU) != NULL) {
+        /* Stop the timer that was left running when the VCPU was disabled */
+        evict_virt_timer(ARCH_NODE_STATE(armHSCurVCPU));
+    }
+#endif
     if (ARCH_NODE_STATE(armHSVCPUActive)) {
         vcpu_disable(NULL);
         ARCH_NODE_STATE(armHSVCPUActive) = false;
     }
+    /* The list registers are left loaded */
+    if (ARCH_NODE_STATE(armHSCurVCPU) != NULL) {
+        ARCH_NODE_STATE(armHSVGICLRDirty) |= ARCH_NODE_STATE(armHSCurVCPU)->vgic.lr_live;
+    }
     ARCH_NODE_STATE(armHSCurVCPU) = NULL;
 }
 
@@ -373,18 +696,145 @@ exception_t decodeVCPUReadReg(cap_t cap, word_t length, bool_t call, word_t *buf
     return invokeVCPUReadReg(VCPU_PTR(cap_vcpu_cap_get_capVCPUPtr(cap)), field, call);
 }
 
+#ifdef CONFIG_VCPU_REG_BATCH
+/* Batch arguments are the count followed by seL4_VCPURegBatchSize (field,
+ * value) pairs, of which the first count are used. The fields are copied out
+ * of the message so that the reply can be written over it. */
+static exception_t decodeVCPURegBatch(word_t length, word_t *buffer, word_t *count,
+                                      word_t *fields, word_t *values)
+{
+    word_t i;
+
+    if (length < 1) {
+        userError("VCPU register batch: Truncated message.");
+        current_syscall_error.type = seL4_TruncatedMessage;
+        return EXCEPTION_SYSCALL_ERROR;
+    }
+    *count = getSyscallArg(0, buffer);
+    if (*count > seL4_VCPURegBatchSize) {
+        userError("VCPU register batch: Too many registers %lu.", (unsigned long)*count);
+        current_syscall_error.type = seL4_RangeError;
+        current_syscall_error.rangeErrorMin = 0;
+        current_syscall_error.rangeErrorMax = seL4_VCPURegBatchSize;
+        return EXCEPTION_SYSCALL_ERROR;
+    }
+    if (length < 1 + 2 * *count) {
+        userError("VCPU register batch: Truncated message.");
+        current_syscall_error.type = seL4_TruncatedMessage;
+        return EXCEPTION_SYSCALL_ERROR;
+    }
+
+    for (i = 0; i < *count; i++) {
+        fields[i] = getSyscallArg(1 + 2 * i, buffer);
+        values[i] = getSyscallArg(2 + 2 * i, buffer);
+        if (fields[i] >= seL4_VCPUReg_Num) {
+            userError("VCPU register batch: Invalid field 0x%lx.", (long)fields[i]);
+            current_syscall_error.type = seL4_InvalidArgument;
+            current_syscall_error.invalidArgumentNumber = 1 + 2 * i;
+            return EXCEPTION_SYSCALL_ERROR;
+        }
+    }
+    return EXCEPTION_NONE;
+}
+
+exception_t invokeVCPUReadRegBatch(vcpu_t *vcpu, word_t count, word_t *fields, bool_t call)
+{
+    tcb_t *thread = NODE_STATE(ksCurThread);
+    word_t i;
+
+    if (call) {
+        word_t *ipcBuffer = lookupIPCBuffer(true, thread);
+        unsigned int length = 0;
+
+        setRegister(thread, badgeRegister, 0);
+        for (i = 0; i < seL4_VCPURegBatchSize; i++) {
+            if (i < count) {
+                setMR(thread, ipcBuffer, 2 * i, fields[i]);
+                length = setMR(thread, ipcBuffer, 2 * i + 1, readVCPUReg(vcpu, fields[i]));
+            } else {
+                setMR(thread, ipcBuffer, 2 * i, 0);
+                length = setMR(thread, ipcBuffer, 2 * i + 1, 0);
+            }
+        }
+        setRegister(thread, msgInfoRegister, wordFromMessageInfo(
+                        seL4_MessageInfo_new(0, 0, 0, length)));
+    }
+    setThreadState(thread, ThreadState_Running);
+    return EXCEPTION_NONE;
+}
+
+exception_t decodeVCPUReadRegBatch(cap_t cap, word_t length, bool_t call, word_t *buffer)
+{
+    word_t count;
+    word_t fields[seL4_VCPURegBatchSize];
+    word_t values[seL4_VCPURegBatchSize];
+    exception_t status;
+
+    status = decodeVCPURegBatch(length, buffer, &count, fields, values);
+    if (status != EXCEPTION_NONE) {
+        return status;
+    }
+
+    setThreadState(NODE_STATE(ksCurThread), ThreadState_Restart);
+    return invokeVCPUReadRegBatch(VCPU_PTR(cap_vcpu_cap_get_capVCPUPtr(cap)), count, fields, call);
+}
+
+exception_t invokeVCPUWriteRegBatch(vcpu_t *vcpu, word_t count, word_t *fields, word_t *values)
+{
+    word_t i;
+
+    for (i = 0; i < count; i++) {
+        writeVCPUReg(vcpu, fields[i], values[i]);
+    }
+    return EXCEPTION_NONE;
+}
+
+exception_t decodeVCPUWriteRegBatch(cap_t cap, word_t length, word_t *buffer)
+{
+    word_t count;
+    word_t fields[seL4_VCPURegBatchSize];
+    word_t values[seL4_VCPURegBatchSize];
+    exception_t status;
+
+    status = decodeVCPURegBatch(length, buffer, &count, fields, values);
+    if (status != EXCEPTION_NONE) {
+        return status;
+    }
+
+    setThreadState(NODE_STATE(ksCurThread), ThreadState_Restart);
+    return invokeVCPUWriteRegBatch(VCPU_PTR(cap_vcpu_cap_get_capVCPUPtr(cap)), count, fields, values);
+}
+#endif /* CONFIG_VCPU_REG_BATCH */
+
 exception_t invokeVCPUInjectIRQ(vcpu_t *vcpu, unsigned long index, virq_t virq)
 {
+#ifdef CONFIG_ARM_HYP_VPPI_INJECT
+    vcpu_vppi_lr_overwritten(vcpu, index);
+#endif
     if (likely(ARCH_NODE_STATE(armHSCurVCPU) == vcpu)) {
         set_gic_vcpu_ctrl_lr(index, virq);
+        vcpu->vgic.lr_live |= ULL_CONST(1) << index;
+#ifdef CONFIG_ARM_HYP_VIRQ_ASYNC
+        /* Supersedes anything another core posted to this list register */
+        vcpu->vgic.lr_posted &= ~(ULL_CONST(1) << index);
+#endif
 #ifdef ENABLE_SMP_SUPPORT
+#ifdef CONFIG_ARM_HYP_VIRQ_ASYNC
+    } else if (vcpu_loaded_remotely(vcpu)) {
+        vcpu->vgic.lr[index] = virq;
+        vcpu->vgic.lr_live |= ULL_CONST(1) << index;
+        vcpu->vgic.lr_posted |= ULL_CONST(1) << index;
+        vcpu_kick(vcpu);
+#else
     } else if (vcpu->vcpuTCB != NULL && vcpu->vcpuTCB->tcbAffinity != getCurrentCPUIndex()) {
         doRemoteOp3Arg(IpiRemoteCall_VCPUInjectInterrupt,
                        (word_t)vcpu, index, virq.words[0],
                        vcpu->vcpuTCB->tcbAffinity);
+#endif /* CONFIG_ARM_HYP_VIRQ_ASYNC */
 #endif /* CONFIG_ENABLE_SMP */
     } else {
         vcpu->vgic.lr[index] = virq;
+        vcpu->vgic.lr_live |= ULL_CONST(1) << index;
     }
 
     return EXCEPTION_NONE;
@@ -490,10 +940,24 @@ exception_t decodeARMVCPUInvocation(
         return decodeVCPUReadReg(cap, length, call, buffer);
     case ARMVCPUWriteReg:
         return decodeVCPUWriteReg(cap, length, buffer);
+#ifdef CONFIG_VCPU_REG_BATCH
+    case ARMVCPUReadRegBatch:
+        return decodeVCPUReadRegBatch(cap, length, call, buffer);
+    case ARMVCPUWriteRegBatch:
+        return decodeVCPUWriteRegBatch(cap, length, buffer);
+#endif
     case ARMVCPUInjectIRQ:
         return decodeVCPUInjectIRQ(cap, length, buffer);
     case ARMVCPUAckVPPI:
         return decodeVCPUAckVPPI(cap, length, buffer);
+#ifdef CONFIG_ARM_HYP_VIRQ_QUEUE
+    case ARMVCPUQueueIRQ:
+        return decodeVCPUQueueIRQ(cap, length, buffer);
+#endif
+#ifdef CONFIG_ARM_HYP_VPPI_INJECT
+    case ARMVCPUSetVPPIInjection:
+        return decodeVCPUSetVPPIInjection(cap, length, buffer);
+#endif
     default:
         userError("VCPU: Illegal operation.");
         current_syscall_error.type = seL4_IllegalOperation;
@@ -535,6 +999,159 @@ exception_t invokeVCPUAckVPPI(vcpu_t *vcpu, VPPIEventIRQ_t vppi)
     return EXCEPTION_NONE;
 }
 
+#ifdef CONFIG_ARM_HYP_VIRQ_QUEUE
+exception_t decodeVCPUQueueIRQ(cap_t cap, word_t length, word_t *buffer)
+{
+    word_t mr0, vid, priority, group;
+    vcpu_t *vcpu = VCPU_PTR(cap_vcpu_cap_get_capVCPUPtr(cap));
+
+    if (length < 1) {
+        current_syscall_error.type = seL4_TruncatedMessage;
+        return EXCEPTION_SYSCALL_ERROR;
+    }
+
+    mr0 = getSyscallArg(0, buffer);
+    vid = mr0 & 0xffff;
+    priority = (mr0 >> 16) & 0xff;
+    group = (mr0 >> 24) & 0xff;
+
+    /* Same limits as decodeVCPUInjectIRQ */
+    if (vid > (1U << 10) - 1) {
+        current_syscall_error.type = seL4_RangeError;
+        current_syscall_error.rangeErrorMin = 0;
+        current_syscall_error.rangeErrorMax = (1U << 10) - 1;
+        current_syscall_error.invalidArgumentNumber = 1;
+        return EXCEPTION_SYSCALL_ERROR;
+    }
+    if (priority > 31) {
+        current_syscall_error.type = seL4_RangeError;
+        current_syscall_error.rangeErrorMin = 0;
+        current_syscall_error.rangeErrorMax = 31;
+        current_syscall_error.invalidArgumentNumber = 2;
+        return EXCEPTION_SYSCALL_ERROR;
+    }
+    if (group > 1) {
+        current_syscall_error.type = seL4_RangeError;
+        current_syscall_error.rangeErrorMin = 0;
+        current_syscall_error.rangeErrorMax = 1;
+        current_syscall_error.invalidArgumentNumber = 3;
+        return EXCEPTION_SYSCALL_ERROR;
+    }
+    /* An IRQ that is already queued is merged with the queued one */
+    if (vcpu->virqQueue.count == CONFIG_ARM_HYP_VIRQ_QUEUE_SIZE && !vcpu_virq_queued(vcpu, vid)) {
+        userError("VCPUQueueIRQ: VIRQ queue full.");
+        current_syscall_error.type = seL4_DeleteFirst;
+        return EXCEPTION_SYSCALL_ERROR;
+    }
+    /* As with InjectIRQ, the guest completing the IRQ raises a VGIC
+     * maintenance fault, which also drains the queue */
+    virq_t virq = virq_virq_pending_new(group, priority, 1, vid);
+
+    setThreadState(NODE_STATE(ksCurThread), ThreadState_Restart);
+    return invokeVCPUQueueIRQ(vcpu, virq);
+}
+
+exception_t invokeVCPUQueueIRQ(vcpu_t *vcpu, virq_t virq)
+{
+#ifdef ENABLE_SMP_SUPPORT
+#ifdef CONFIG_ARM_HYP_VIRQ_ASYNC
+    if (ARCH_NODE_STATE(armHSCurVCPU) != vcpu && vcpu_loaded_remotely(vcpu)) {
+        /* The other core drains the queue when it is kicked */
+        vcpu_virq_queue_add(vcpu, virq);
+        vcpu_kick(vcpu);
+        return EXCEPTION_NONE;
+    }
+#else
+    if (ARCH_NODE_STATE(armHSCurVCPU) != vcpu &&
+        vcpu->vcpuTCB != NULL && vcpu->vcpuTCB->tcbAffinity != getCurrentCPUIndex()) {
+        doRemoteOp2Arg(IpiRemoteCall_VCPUQueueInterrupt, (word_t)vcpu, virq.words[0],
+                       vcpu->vcpuTCB->tcbAffinity);
+        return EXCEPTION_NONE;
+    }
+#endif /* CONFIG_ARM_HYP_VIRQ_ASYNC */
+#endif
+    vcpu_virq_queue_push(vcpu, virq);
+    return EXCEPTION_NONE;
+}
+#endif /* CONFIG_ARM_HYP_VIRQ_QUEUE */
+
+#ifdef CONFIG_ARM_HYP_VPPI_INJECT
+exception_t decodeVCPUSetVPPIInjection(cap_t cap, word_t length, word_t *buffer)
+{
+    word_t mr1, vid, priority, group, enable;
+    vcpu_t *vcpu = VCPU_PTR(cap_vcpu_cap_get_capVCPUPtr(cap));
+
+#ifdef CONFIG_ARCH_AARCH64
+    if (length < 2) {
+#else
+    if (length < 3) {
+#endif
+        current_syscall_error.type = seL4_TruncatedMessage;
+        return EXCEPTION_SYSCALL_ERROR;
+    }
+
+    word_t irq_w = getSyscallArg(0, buffer);
+    irq_t irq = (irq_t) CORE_IRQ_TO_IRQT(CURRENT_CPU_INDEX(), irq_w);
+    exception_t status = Arch_checkIRQ(irq_w);
+    if (status != EXCEPTION_NONE) {
+        return status;
+    }
+
+    VPPIEventIRQ_t vppi = irqVPPIEventIndex(irq);
+    if (vppi == VPPIEventIRQ_invalid) {
+        userError("VCPUSetVPPIInjection: Invalid irq number.");
+        current_syscall_error.type = seL4_InvalidArgument;
+        current_syscall_error.invalidArgumentNumber = 0;
+        return EXCEPTION_SYSCALL_ERROR;
+    }
+
+    mr1 = getSyscallArg(1, buffer);
+    vid = mr1 & 0xffff;
+    priority = (mr1 >> 16) & 0xff;
+    group = (mr1 >> 24) & 0xff;
+#ifdef CONFIG_ARCH_AARCH64
+    enable = (mr1 >> 32) & 1;
+#else
+    enable = getSyscallArg(2, buffer) & 1;
+#endif
+
+    if (vid > (1U << 10) - 1) {
+        current_syscall_error.type = seL4_RangeError;
+        current_syscall_error.rangeErrorMin = 0;
+        current_syscall_error.rangeErrorMax = (1U << 10) - 1;
+        current_syscall_error.invalidArgumentNumber = 1;
+        return EXCEPTION_SYSCALL_ERROR;
+    }
+    if (priority > 31) {
+        current_syscall_error.type = seL4_RangeError;
+        current_syscall_error.rangeErrorMin = 0;
+        current_syscall_error.rangeErrorMax = 31;
+        current_syscall_error.invalidArgumentNumber = 2;
+        return EXCEPTION_SYSCALL_ERROR;
+    }
+    if (group > 1) {
+        current_syscall_error.type = seL4_RangeError;
+        current_syscall_error.rangeErrorMin = 0;
+        current_syscall_error.rangeErrorMax = 1;
+        current_syscall_error.invalidArgumentNumber = 3;
+        return EXCEPTION_SYSCALL_ERROR;
+    }
+
+    setThreadState(NODE_STATE(ksCurThread), ThreadState_Restart);
+    if (enable) {
+        return invokeVCPUSetVPPIInjection(vcpu, vppi, virq_virq_pending_new(group, priority, 1, vid));
+    }
+    return invokeVCPUSetVPPIInjection(vcpu, vppi, virq_empty);
+}
+
+exception_t invokeVCPUSetVPPIInjection(vcpu_t *vcpu, VPPIEventIRQ_t vppi, virq_t virq)
+{
+    /* An event already injected is still completed by the kernel */
+    vcpu->vppiInject.virq[vppi] = virq;
+    return EXCEPTION_NONE;
+}
+#endif /* CONFIG_ARM_HYP_VPPI_INJECT */
+
 exception_t decodeVCPUSetTCB(cap_t cap)
 {
     cap_t tcbCap;
@@ -585,7 +1202,31 @@ void handleVCPUInjectInterruptIPI(vcpu_t *vcpu, unsigned long index, virq_t virq
     } else {
         vcpu->vgic.lr[index] = virq;
     }
+    vcpu->vgic.lr_live |= ULL_CONST(1) << index;
 }
+
+#ifdef CONFIG_ARM_HYP_VIRQ_QUEUE
+void handleVCPUQueueInterruptIPI(vcpu_t *vcpu, virq_t virq)
+{
+    vcpu_virq_queue_push(vcpu, virq);
+}
+#endif
+
+#ifdef CONFIG_ARM_HYP_VIRQ_ASYNC
+/* Called on a reschedule IPI, which is how other cores kick this core after
+ * posting interrupts to the VCPU loaded on it */
+void handleVCPUPostedInterruptsIPI(void)
+{
+    vcpu_t *vcpu = ARCH_NODE_STATE(armHSCurVCPU);
+
+    if (vcpu != NULL) {
+        vcpu_merge_posted(vcpu);
+#ifdef CONFIG_ARM_HYP_VIRQ_QUEUE
+        vcpu_virq_queue_drain(vcpu, true);
+#endif
+    }
+}
+#endif
 #endif /* ENABLE_SMP_SUPPORT */
 
 #endif
@@ -68,6 +68,15 @@ static void handleRemoteCall(IpiModeRemoteCall_t call, word_t arg0,
         }
 #endif
 
+#if defined CONFIG_ARM_HYP_VIRQ_QUEUE && defined ENABLE_SMP_SUPPORT
+        case IpiRemoteCall_VCPUQueueInterrupt: {
+            virq_t virq;
+            virq.words[0] = arg1;
+            handleVCPUQueueInterruptIPI((vcpu_t *) arg0, virq);
+            break;
+        }
+#endif
+
         default:
             fail("Invalid remote call");
             break;
@@ -38,6 +38,18 @@ config_option(
     DEPENDS "KernelArchRiscV"
 )
 
+config_option(
+    KernelRiscvHWASIDAllocator RISCV_HW_ASID_ALLOCATOR
+    "Probe the number of implemented hardware ASID bits at boot and map seL4 \
+    ASIDs to hardware ASIDs. If the hardware ASIDs are narrower than seL4 \
+    ASIDs, they are allocated in generations and reclaimed together with a \
+    single TLB flush once exhausted. Context switches then no longer flush \
+    the TLB, unless the hardware does not implement ASIDs at all."
+    DEFAULT OFF
+    DEPENDS "KernelArchRiscV;NOT KernelVerificationBuild"
+    DEFAULT_DISABLED OFF
+)
+
 # Until RISC-V has instructions to count leading/trailing zeros, we provide
 # library implementations. Platforms that implement the bit manipulation
 # extension can override these settings to remove the library functions from
@@ -17,6 +17,7 @@
 #include <machine/io.h>
 #include <model/preemption.h>
 #include <model/statedata.h>
+#include <benchmark/benchmark_preemption.h>
 #include <object/cnode.h>
 #include <object/untyped.h>
 #include <arch/api/invocation.h>
@@ -300,8 +301,52 @@ BOOT_CODE cap_t create_it_address_space(cap_t root_cnode_cap, v_region_t it_v_re
     return lvl1pt_cap;
 }
 
+#ifdef CONFIG_RISCV_HW_ASID_ALLOCATOR
+/* Find the number of ASID bits implemented by this hart by writing all ones to
+ * the ASID field of satp and reading back which of them stuck. */
+BOOT_CODE static word_t probeHWASIDBits(void)
+{
+    satp_t satp;
+    word_t asid_bits;
+
+    satp = satp_new(SATP_MODE, MASK(ASID_BITS),
+                    kpptr_to_paddr(&kernel_root_pageTable) >> seL4_PageBits);
+    write_satp(satp.words[0]);
+    satp.words[0] = read_satp();
+    asid_bits = satp_get_asid(satp) ? wordBits - clzl(satp_get_asid(satp)) : 0;
+    /* Drop anything cached under the probed ASID, it may be handed out later */
+#ifdef ENABLE_SMP_SUPPORT
+    sfence_local();
+#else
+    sfence();
+#endif
+
+    if (asid_bits < ASID_BITS) {
+        /* Allocated hardware ASIDs are stored in the alignment bits of ASID
+         * pool entries. At least one of them has to remain allocatable when
+         * every core holds on to its active one across a rollover. */
+        asid_bits = MIN(asid_bits, HW_ASID_TAG_BITS);
+        if (MASK(asid_bits) <= CONFIG_MAX_NUM_NODES) {
+            asid_bits = 0;
+        }
+    }
+
+    return asid_bits;
+}
+#endif
+
 BOOT_CODE void activate_kernel_vspace(void)
 {
+#ifdef CONFIG_RISCV_HW_ASID_ALLOCATOR
+    /* All harts share one allocator, whose width is set by the boot hart.
+     * Secondary harts get here before taking the kernel lock, so they must
+     * not update it and can only check that they implement enough bits. */
+    if (CURRENT_CPU_INDEX() == 0) {
+        riscvKSHWASIDBits = probeHWASIDBits();
+    } else if (probeHWASIDBits() < riscvKSHWASIDBits) {
+        fail("Hart implements fewer ASID bits than the boot hart");
+    }
+#endif
     setVSpaceRoot(kpptr_to_paddr(&kernel_root_pageTable), 0);
 }
 
@@ -330,6 +375,9 @@ static findVSpaceForASID_ret_t findVSpaceForASID(asid_t asid)
     }
 
     vspace_root = poolPtr->array[asid & MASK(asidLowBits)];
+#ifdef CONFIG_RISCV_HW_ASID_ALLOCATOR
+    vspace_root = asidPoolEntryVSpace(vspace_root);
+#endif
     if (!vspace_root) {
         current_lookup_fault = lookup_fault_invalid_root_new();
 
@@ -439,13 +487,26 @@ exception_t handleVMFault(tcb_t *thread, vm_fault_type_t vm_faultType)
 
 void deleteASIDPool(asid_t asid_base, asid_pool_t *pool)
 {
+#ifdef CONFIG_BENCHMARK_PREEMPTION_LATENCY
+    word_t prev_op = benchmark_preemption_op(BENCHMARK_PREEMPTION_OP_DELETE_ASID_POOL);
+#endif
     /* Haskell error: "ASID pool's base must be aligned" */
     assert(IS_ALIGNED(asid_base, asidLowBits));
 
     if (riscvKSASIDTable[asid_base >> asidLowBits] == pool) {
+#ifdef CONFIG_RISCV_HW_ASID_ALLOCATOR
+        /* seL4 ASIDs used directly as hardware ASIDs may be handed out again
+         * with the next pool, see deleteASID(). */
+        if (riscvKSHWASIDBits == ASID_BITS) {
+            sfence();
+        }
+#endif
         riscvKSASIDTable[asid_base >> asidLowBits] = NULL;
         setVMRoot(NODE_STATE(ksCurThread));
     }
+#ifdef CONFIG_BENCHMARK_PREEMPTION_LATENCY
+    benchmark_preemption_op(prev_op);
+#endif
 }
 
 static exception_t performASIDControlInvocation(void *frame, cte_t *slot, cte_t *parent, asid_t asid_base)
@@ -489,13 +550,106 @@ static exception_t performASIDPoolInvocation(asid_t asid, asid_pool_t *poolPtr,
     return EXCEPTION_NONE;
 }
 
+#ifdef CONFIG_RISCV_HW_ASID_ALLOCATOR
+static bool_t isReservedHWASID(word_t hw_asid)
+{
+    word_t i;
+
+    for (i = 0; i < CONFIG_MAX_NUM_NODES; i++) {
+        if (riscvKSReservedHWASIDs[i] == hw_asid) {
+            return true;
+        }
+    }
+    return false;
+}
+
+/* Start a new hardware ASID generation. The hardware ASIDs active on any core
+ * are kept and excluded from allocation, all others are dropped and the TLBs
+ * of all harts are flushed once for all of them. */
+static void rolloverHWASIDs(void)
+{
+    word_t i, j;
+
+    for (i = 0; i < CONFIG_MAX_NUM_NODES; i++) {
+        riscvKSReservedHWASIDs[i] = ARCH_NODE_STATE_ON_CORE(riscvKSActiveHWASID, i);
+    }
+
+    for (i = 0; i < nASIDPools; i++) {
+        asid_pool_t *poolPtr = riscvKSASIDTable[i];
+        if (poolPtr == NULL) {
+            continue;
+        }
+        for (j = 0; j < BIT(asidLowBits); j++) {
+            pte_t *entry = poolPtr->array[j];
+            if (asidPoolEntryHWASID(entry) != 0 && !isReservedHWASID(asidPoolEntryHWASID(entry))) {
+                poolPtr->array[j] = asidPoolEntryVSpace(entry);
+            }
+        }
+    }
+
+    sfence();
+    riscvKSNextHWASID = 1;
+}
+
+static word_t findFreeHWASID(void)
+{
+    word_t hw_asid;
+
+    /* Hardware ASID 0 is never handed out, so riscvKSNextHWASID wrapping to 0
+     * marks the end of a generation. This includes the very first allocation. */
+    do {
+        if (riscvKSNextHWASID == 0) {
+            rolloverHWASIDs();
+        }
+        hw_asid = riscvKSNextHWASID;
+        riscvKSNextHWASID = (hw_asid + 1) & MASK(riscvKSHWASIDBits);
+    } while (isReservedHWASID(hw_asid));
+
+    return hw_asid;
+}
+
+/* The hardware ASID of the address space mapped at a valid ASID, allocating
+ * one if it has none in the current generation. */
+static word_t getHWASID(asid_t asid)
+{
+    asid_pool_t *poolPtr;
+    word_t hw_asid;
+
+    if (riscvKSHWASIDBits == ASID_BITS) {
+        return asid;
+    }
+    if (riscvKSHWASIDBits == 0) {
+        return 0;
+    }
+
+    poolPtr = riscvKSASIDTable[asid >> asidLowBits];
+    hw_asid = asidPoolEntryHWASID(poolPtr->array[asid & MASK(asidLowBits)]);
+    if (hw_asid == 0) {
+        /* Allocating may roll over, which rewrites the pool entries. */
+        hw_asid = findFreeHWASID();
+        poolPtr->array[asid & MASK(asidLowBits)] =
+            PTE_PTR(PTE_REF(poolPtr->array[asid & MASK(asidLowBits)]) | hw_asid);
+    }
+    return hw_asid;
+}
+#endif /* CONFIG_RISCV_HW_ASID_ALLOCATOR */
+
 void deleteASID(asid_t asid, pte_t *vspace)
 {
     asid_pool_t *poolPtr;
 
     poolPtr = riscvKSASIDTable[asid >> asidLowBits];
+#ifdef CONFIG_RISCV_HW_ASID_ALLOCATOR
+    if (poolPtr != NULL && asidPoolEntryVSpace(poolPtr->array[asid & MASK(asidLowBits)]) == vspace) {
+        /* An allocated hardware ASID is not reused before the next rollover
+         * flushes it, so only seL4 ASIDs used directly need a flush here. */
+        if (riscvKSHWASIDBits == ASID_BITS) {
+            hwASIDFlush(asid);
+        }
+#else
     if (poolPtr != NULL && poolPtr->array[asid & MASK(asidLowBits)] == vspace) {
         hwASIDFlush(asid);
+#endif
         poolPtr->array[asid & MASK(asidLowBits)] = NULL;
         setVMRoot(NODE_STATE(ksCurThread));
     }
@@ -596,6 +750,10 @@ void setVMRoot(tcb_t *tcb)
         return;
     }
 
+#ifdef CONFIG_RISCV_HW_ASID_ALLOCATOR
+    asid = getHWASID(asid);
+    ARCH_NODE_STATE(riscvKSActiveHWASID) = asid;
+#endif
     setVSpaceRoot(addrFromPPtr(lvl1pt), asid);
 }
 
@@ -678,9 +836,167 @@ static inline bool_t CONST checkVPAlignment(vm_page_size_t sz, word_t w)
     return (w & MASK(pageBitsForSize(sz))) == 0;
 }
 
+#ifdef CONFIG_FRAME_MAP_RANGE
+static exception_t performPageTableInvocationMapRange(asid_t asid, pte_t *lvl1pt, cte_t *window,
+                                                      word_t numFrames, vptr_t vaddr,
+                                                      seL4_CapRights_t rights, bool_t executable)
+{
+    pte_t *ptSlot = NULL;
+    word_t i;
+
+    for (i = 0; i < numFrames; i++) {
+        vptr_t va = vaddr + (i << seL4_PageBits);
+        cap_t cap = window[i].cap;
+
+        /* Only walk the page tables when entering a new leaf table */
+        if (i == 0 || IS_ALIGNED(va, PT_INDEX_BITS + seL4_PageBits)) {
+            ptSlot = lookupPTSlot(lvl1pt, va).ptSlot;
+        }
+
+        vm_rights_t vmRights = maskVMRights(cap_frame_cap_get_capFVMRights(cap), rights);
+        paddr_t frame_paddr = addrFromPPtr((void *) cap_frame_cap_get_capFBasePtr(cap));
+
+        cap = cap_frame_cap_set_capFMappedASID(cap, asid);
+        cap = cap_frame_cap_set_capFMappedAddress(cap, va);
+        window[i].cap = cap;
+
+        *ptSlot = makeUserPTE(frame_paddr, executable, vmRights);
+        ptSlot++;
+    }
+
+    /* A single fence covers the whole range */
+    sfence();
+    return EXCEPTION_NONE;
+}
+
+static exception_t decodeRISCVPageTableMapRange(word_t length, cap_t cap, word_t *buffer)
+{
+    if (unlikely(length < 7 || current_extra_caps.excaprefs[0] == NULL)) {
+        userError("RISCVPageTableMapRange: Truncated message.");
+        current_syscall_error.type = seL4_TruncatedMessage;
+        return EXCEPTION_SYSCALL_ERROR;
+    }
+
+    cptr_t nodeIndex = getSyscallArg(0, buffer);
+    word_t nodeDepth = getSyscallArg(1, buffer);
+    word_t nodeOffset = getSyscallArg(2, buffer);
+    word_t numFrames = getSyscallArg(3, buffer);
+    word_t vaddr = getSyscallArg(4, buffer);
+    seL4_CapRights_t rights = rightsFromWord(getSyscallArg(5, buffer));
+    vm_attributes_t attr = vmAttributesFromWord(getSyscallArg(6, buffer));
+
+    if (unlikely(!isValidVTableRoot(cap))) {
+        userError("RISCVPageTableMapRange: Invalid top-level PageTable.");
+        current_syscall_error.type = seL4_InvalidCapability;
+        current_syscall_error.invalidCapNumber = 0;
+        return EXCEPTION_SYSCALL_ERROR;
+    }
+
+    pte_t *lvl1pt = PTE_PTR(cap_page_table_cap_get_capPTBasePtr(cap));
+    asid_t asid = cap_page_table_cap_get_capPTMappedASID(cap);
+
+    findVSpaceForASID_ret_t find_ret = findVSpaceForASID(asid);
+    if (unlikely(find_ret.status != EXCEPTION_NONE)) {
+        userError("RISCVPageTableMapRange: No PageTable for ASID");
+        current_syscall_error.type = seL4_FailedLookup;
+        current_syscall_error.failedLookupWasSource = false;
+        return EXCEPTION_SYSCALL_ERROR;
+    }
+
+    if (unlikely(find_ret.vspace_root != lvl1pt)) {
+        userError("RISCVPageTableMapRange: ASID lookup failed");
+        current_syscall_error.type = seL4_InvalidCapability;
+        current_syscall_error.invalidCapNumber = 0;
+        return EXCEPTION_SYSCALL_ERROR;
+    }
+
+    lookupSlotWindow_ret_t window_ret = lookupSourceWindow(current_extra_caps.excaprefs[0]->cap,
+                                                           nodeIndex, nodeDepth, nodeOffset,
+                                                           numFrames, CONFIG_MAP_RANGE_MAX_FRAMES);
+    if (unlikely(window_ret.status != EXCEPTION_NONE)) {
+        userError("RISCVPageTableMapRange: Invalid frame window.");
+        return window_ret.status;
+    }
+
+    if (unlikely(!IS_ALIGNED(vaddr, seL4_PageBits))) {
+        current_syscall_error.type = seL4_AlignmentError;
+        return EXCEPTION_SYSCALL_ERROR;
+    }
+
+    /* numFrames is bounded by CONFIG_MAP_RANGE_MAX_FRAMES, so the size of the
+     * range cannot overflow. */
+    if (unlikely(vaddr >= USER_TOP || (numFrames << seL4_PageBits) - 1 >= USER_TOP - vaddr)) {
+        current_syscall_error.type = seL4_InvalidArgument;
+        current_syscall_error.invalidArgumentNumber = 4;
+        return EXCEPTION_SYSCALL_ERROR;
+    }
+
+    pte_t *ptSlot = NULL;
+    for (word_t i = 0; i < numFrames; i++) {
+        cap_t frameCap = window_ret.window[i].cap;
+        word_t va = vaddr + (i << seL4_PageBits);
+
+        if (unlikely(cap_get_capType(frameCap) != cap_frame_cap ||
+                     cap_frame_cap_get_capFSize(frameCap) != RISCV_4K_Page)) {
+            userError("RISCVPageTableMapRange: Slot #%lu is not a small frame cap.",
+                      (long)(nodeOffset + i));
+            current_syscall_error.type = seL4_InvalidCapability;
+            current_syscall_error.invalidCapNumber = 1;
+            return EXCEPTION_SYSCALL_ERROR;
+        }
+
+        if (i == 0 || IS_ALIGNED(va, PT_INDEX_BITS + seL4_PageBits)) {
+            lookupPTSlot_ret_t lu_ret = lookupPTSlot(lvl1pt, va);
+            if (unlikely(lu_ret.ptBitsLeft != seL4_PageBits)) {
+                current_lookup_fault = lookup_fault_missing_capability_new(lu_ret.ptBitsLeft);
+                current_syscall_error.type = seL4_FailedLookup;
+                current_syscall_error.failedLookupWasSource = false;
+                return EXCEPTION_SYSCALL_ERROR;
+            }
+            ptSlot = lu_ret.ptSlot;
+        }
+
+        asid_t frame_asid = cap_frame_cap_get_capFMappedASID(frameCap);
+        if (unlikely(frame_asid != asidInvalid)) {
+            /* this frame is already mapped, it may only be remapped in place */
+            if (frame_asid != asid) {
+                userError("RISCVPageTableMapRange: Frame in slot #%lu belongs to a different address space.",
+                          (long)(nodeOffset + i));
+                current_syscall_error.type = seL4_InvalidCapability;
+                current_syscall_error.invalidCapNumber = 1;
+                return EXCEPTION_SYSCALL_ERROR;
+            }
+            if (cap_frame_cap_get_capFMappedAddress(frameCap) != va) {
+                userError("RISCVPageTableMapRange: Frame in slot #%lu is mapped at a different address.",
+                          (long)(nodeOffset + i));
+                current_syscall_error.type = seL4_InvalidArgument;
+                current_syscall_error.invalidArgumentNumber = 4;
+                return EXCEPTION_SYSCALL_ERROR;
+            }
+        } else if (unlikely(pte_ptr_get_valid(ptSlot))) {
+            userError("Virtual address (0x%"SEL4_PRIx_word") already mapped", va);
+            current_syscall_error.type = seL4_DeleteFirst;
+            return EXCEPTION_SYSCALL_ERROR;
+        }
+        ptSlot++;
+    }
+
+    bool_t executable = !vm_attributes_get_riscvExecuteNever(attr);
+    setThreadState(NODE_STATE(ksCurThread), ThreadState_Restart);
+    return performPageTableInvocationMapRange(asid, lvl1pt, window_ret.window, numFrames, vaddr,
+                                              rights, executable);
+}
+#endif /* CONFIG_FRAME_MAP_RANGE */
+
 static exception_t decodeRISCVPageTableInvocation(word_t label, word_t length,
                                                   cte_t *cte, cap_t cap, word_t *buffer)
 {
+#ifdef CONFIG_FRAME_MAP_RANGE
+    if (label == RISCVPageTableMapRange) {
+        return decodeRISCVPageTableMapRange(length, cap, buffer);
+    }
+#endif
+
     if (label == RISCVPageTableUnmap) {
         if (unlikely(!isFinalCapability(cte))) {
             userError("RISCVPageTableUnmap: cannot unmap if more than once cap exists");
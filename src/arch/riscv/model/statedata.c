@@ -17,6 +17,21 @@
 /* The top level asid mapping table */
 asid_pool_t *riscvKSASIDTable[BIT(asidHighBits)];
 
+#ifdef CONFIG_RISCV_HW_ASID_ALLOCATOR
+UP_STATE_DEFINE(word_t, riscvKSActiveHWASID);
+
+/* Number of hardware ASID bits in use. ASID_BITS means that seL4 ASIDs are
+ * used as hardware ASIDs directly, zero that the harts implement too few ASID
+ * bits to use them at all. */
+word_t riscvKSHWASIDBits;
+/* The next hardware ASID to hand out in the current generation. Zero means
+ * that the current generation is exhausted and a rollover is due. */
+word_t riscvKSNextHWASID;
+/* Hardware ASIDs that were active on a core when the current generation
+ * started and are therefore excluded from allocation until the next rollover. */
+word_t riscvKSReservedHWASIDs[CONFIG_MAX_NUM_NODES];
+#endif
+
 /* Kernel Page Tables */
 pte_t kernel_root_pageTable[BIT(PT_INDEX_BITS)] ALIGN_BSS(BIT(seL4_PageTableBits));
 
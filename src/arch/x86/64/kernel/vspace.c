@@ -8,6 +8,7 @@
 #include <api/syscall.h>
 #include <machine/io.h>
 #include <kernel/boot.h>
+#include <kernel/cspace.h>
 #include <model/statedata.h>
 #include <arch/kernel/vspace.h>
 #include <arch/kernel/boot.h>
@@ -16,6 +17,7 @@
 #include <mode/kernel/tlb.h>
 #include <arch/kernel/tlb_bitmap.h>
 #include <object/structures.h>
+#include <benchmark/benchmark_sample.h>
 
 /* When using the SKIM window to isolate the kernel from the user we also need to
  * not use global mappings as having global mappings and entries in the TLB is
@@ -1049,8 +1051,101 @@ lookupPDSlot_ret_t lookupPDSlot(vspace_root_t *pml4, vptr_t vptr)
     }
 }
 
+#ifdef CONFIG_X86_RANGE_TLB_INVALIDATION
+static inline bool_t collectMapping(tlb_flush_list_t *list, vptr_t vptr)
+{
+    if (list->count >= CONFIG_X86_RANGE_TLB_INVALIDATION_MAX_PAGES) {
+        return false;
+    }
+    list->vaddrs[list->count++] = vptr;
+    return true;
+}
+
+/* Each scanned table counts against the budget, so that a sparsely populated
+ * structure cannot make the collection more expensive than the PCID flush. */
+static inline bool_t collectTable(tlb_flush_list_t *list)
+{
+    if (list->tables >= CONFIG_X86_RANGE_TLB_INVALIDATION_MAX_PAGES) {
+        return false;
+    }
+    list->tables++;
+    return true;
+}
+
+bool_t collectTableMappings(tlb_flush_list_t *list, pte_t *pt, vptr_t vptr)
+{
+    word_t i;
+
+    if (!collectTable(list)) {
+        return false;
+    }
+    for (i = 0; i < BIT(PT_INDEX_BITS); i++) {
+        if (pte_ptr_get_present(pt + i) && !collectMapping(list, vptr + (i << PAGE_BITS))) {
+            return false;
+        }
+    }
+    return true;
+}
+
+static bool_t collectPDMappings(tlb_flush_list_t *list, pde_t *pd, vptr_t vptr)
+{
+    word_t i;
+
+    if (!collectTable(list)) {
+        return false;
+    }
+    for (i = 0; i < BIT(PD_INDEX_BITS); i++) {
+        pde_t *pdSlot = pd + i;
+        vptr_t va = vptr + (i << PD_INDEX_OFFSET);
+
+        if (pde_ptr_get_page_size(pdSlot) == pde_pde_pt) {
+            if (pde_pde_pt_ptr_get_present(pdSlot) &&
+                !collectTableMappings(list, paddr_to_pptr(pde_pde_pt_ptr_get_pt_base_address(pdSlot)), va)) {
+                return false;
+            }
+        } else if (pde_pde_large_ptr_get_present(pdSlot) && !collectMapping(list, va)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+static bool_t collectPDPTMappings(tlb_flush_list_t *list, pdpte_t *pdpt, vptr_t vptr)
+{
+    word_t i;
+
+    if (!collectTable(list)) {
+        return false;
+    }
+    for (i = 0; i < BIT(PDPT_INDEX_BITS); i++) {
+        pdpte_t *pdptSlot = pdpt + i;
+        vptr_t va = vptr + (i << PDPT_INDEX_OFFSET);
+
+        if (pdpte_ptr_get_page_size(pdptSlot) == pdpte_pdpte_pd) {
+            if (pdpte_pdpte_pd_ptr_get_present(pdptSlot) &&
+                !collectPDMappings(list, paddr_to_pptr(pdpte_pdpte_pd_ptr_get_pd_base_address(pdptSlot)), va)) {
+                return false;
+            }
+        } else if (pdpte_pdpte_1g_ptr_get_present(pdptSlot) && !collectMapping(list, va)) {
+            return false;
+        }
+    }
+    return true;
+}
+#endif /* CONFIG_X86_RANGE_TLB_INVALIDATION */
+
 static void flushPD(vspace_root_t *vspace, word_t vptr, pde_t *pd, asid_t asid)
 {
+#ifdef CONFIG_X86_RANGE_TLB_INVALIDATION
+    tlb_flush_list_t list;
+
+    list.count = 0;
+    list.tables = 0;
+    if (collectPDMappings(&list, pd, vptr)) {
+        invalidateTranslationList(&list, asid, SMP_TERNARY(tlb_bitmap_get(vspace), 0));
+        return;
+    }
+#endif
     /* clearing the entire PCID vs flushing the virtual addresses
      * one by one using invplg.
      * choose the easy way, invalidate the PCID
@@ -1061,6 +1156,16 @@ static void flushPD(vspace_root_t *vspace, word_t vptr, pde_t *pd, asid_t asid)
 
 static void flushPDPT(vspace_root_t *vspace, word_t vptr, pdpte_t *pdpt, asid_t asid)
 {
+#ifdef CONFIG_X86_RANGE_TLB_INVALIDATION
+    tlb_flush_list_t list;
+
+    list.count = 0;
+    list.tables = 0;
+    if (collectPDPTMappings(&list, pdpt, vptr)) {
+        invalidateTranslationList(&list, asid, SMP_TERNARY(tlb_bitmap_get(vspace), 0));
+        return;
+    }
+#endif
     /* similar here */
     invalidateASID(vspace, asid, SMP_TERNARY(tlb_bitmap_get(vspace), 0));
     return;
@@ -1267,6 +1372,13 @@ static void unmapPDPT(asid_t asid, vptr_t vaddr, pdpte_t *pdpt)
     flushPDPT(find_ret.vspace_root, vaddr, pdpt, asid);
 
     *pml4Slot = makeUserPML4EInvalid();
+
+#ifdef CONFIG_X86_RANGE_TLB_INVALIDATION
+    /* flushPDPT only invalidates the collected leaf mappings, which may be
+     * none, so drop any cached walks through the removed PDPT as well */
+    invalidatePageStructureCacheASID(pptr_to_paddr(find_ret.vspace_root), asid,
+                                     SMP_TERNARY(tlb_bitmap_get(find_ret.vspace_root), 0));
+#endif
 }
 
 static exception_t performX64PDPTInvocationUnmap(cap_t cap, cte_t *ctSlot)
@@ -1401,6 +1513,190 @@ static exception_t decodeX64PDPTInvocation(
     return performX64PDPTInvocationMap(cap, cte, pml4e, pml4Slot, vspace);
 }
 
+#ifdef CONFIG_FRAME_MAP_RANGE
+static exception_t performX64PML4InvocationMapRange(asid_t asid, vspace_root_t *vspace, cte_t *window,
+                                                    word_t numFrames, vptr_t vaddr,
+                                                    seL4_CapRights_t rights, vm_attributes_t attr)
+{
+    pte_t *ptSlot = NULL;
+    word_t i;
+
+    for (i = 0; i < numFrames; i++) {
+        vptr_t va = vaddr + (i << PAGE_BITS);
+        cap_t cap = window[i].cap;
+        vm_rights_t vmRights;
+        paddr_t paddr;
+
+        /* Only walk the paging structures when entering a new page table */
+        if (i == 0 || IS_ALIGNED(va, PT_INDEX_BITS + PAGE_BITS)) {
+            ptSlot = lookupPTSlot(vspace, va).ptSlot;
+        }
+
+        vmRights = maskVMRights(cap_frame_cap_get_capFVMRights(cap), rights);
+        paddr = pptr_to_paddr((void *)cap_frame_cap_get_capFBasePtr(cap));
+
+        cap = cap_frame_cap_set_capFMappedASID(cap, asid);
+        cap = cap_frame_cap_set_capFMappedAddress(cap, va);
+        cap = cap_frame_cap_set_capFMapType(cap, X86_MappingVSpace);
+        window[i].cap = cap;
+
+        *ptSlot = makeUserPTE(paddr, attr, vmRights);
+        ptSlot++;
+    }
+
+    /* A single invalidation covers the whole range */
+    invalidatePageStructureCacheASID(pptr_to_paddr(vspace), asid,
+                                     SMP_TERNARY(tlb_bitmap_get(vspace), 0));
+    return EXCEPTION_NONE;
+}
+
+static exception_t decodeX64PML4Invocation(
+    word_t  label,
+    word_t  length,
+    cte_t   *cte,
+    cap_t   cap,
+    word_t  *buffer)
+{
+    word_t                  nodeDepth, nodeOffset, numFrames, i;
+    cptr_t                  nodeIndex;
+    vptr_t                  vaddr;
+    seL4_CapRights_t        rights;
+    vm_attributes_t         attr;
+    vspace_root_t          *vspace;
+    asid_t                  asid;
+    findVSpaceForASID_ret_t find_ret;
+    lookupSlotWindow_ret_t  window_ret;
+    lookupPTSlot_ret_t      lu_ret;
+
+    if (label != X64PML4MapRange) {
+        userError("X64PML4: Illegal operation.");
+        current_syscall_error.type = seL4_IllegalOperation;
+        return EXCEPTION_SYSCALL_ERROR;
+    }
+
+    if (length < 7 || current_extra_caps.excaprefs[0] == NULL) {
+        userError("X64PML4 MapRange: Truncated message.");
+        current_syscall_error.type = seL4_TruncatedMessage;
+        return EXCEPTION_SYSCALL_ERROR;
+    }
+
+    nodeIndex  = getSyscallArg(0, buffer);
+    nodeDepth  = getSyscallArg(1, buffer);
+    nodeOffset = getSyscallArg(2, buffer);
+    numFrames  = getSyscallArg(3, buffer);
+    vaddr      = getSyscallArg(4, buffer);
+    rights     = rightsFromWord(getSyscallArg(5, buffer));
+    attr       = vmAttributesFromWord(getSyscallArg(6, buffer));
+
+    if (!isValidNativeRoot(cap)) {
+        current_syscall_error.type = seL4_InvalidCapability;
+        current_syscall_error.invalidCapNumber = 0;
+
+        return EXCEPTION_SYSCALL_ERROR;
+    }
+
+    vspace = (vspace_root_t *)pptr_of_cap(cap);
+    asid = cap_get_capMappedASID(cap);
+
+    find_ret = findVSpaceForASID(asid);
+    if (find_ret.status != EXCEPTION_NONE) {
+        current_syscall_error.type = seL4_FailedLookup;
+        current_syscall_error.failedLookupWasSource = false;
+
+        return EXCEPTION_SYSCALL_ERROR;
+    }
+
+    if (find_ret.vspace_root != vspace) {
+        current_syscall_error.type = seL4_InvalidCapability;
+        current_syscall_error.invalidCapNumber = 0;
+
+        return EXCEPTION_SYSCALL_ERROR;
+    }
+
+    window_ret = lookupSourceWindow(current_extra_caps.excaprefs[0]->cap, nodeIndex, nodeDepth,
+                                    nodeOffset, numFrames, CONFIG_MAP_RANGE_MAX_FRAMES);
+    if (window_ret.status != EXCEPTION_NONE) {
+        userError("X64PML4 MapRange: Invalid frame window.");
+        return window_ret.status;
+    }
+
+    if (!IS_ALIGNED(vaddr, PAGE_BITS)) {
+        current_syscall_error.type = seL4_AlignmentError;
+
+        return EXCEPTION_SYSCALL_ERROR;
+    }
+
+    /* numFrames is bounded by CONFIG_MAP_RANGE_MAX_FRAMES, so the size of
+     * the range cannot overflow. */
+    if (vaddr > USER_TOP || (numFrames << PAGE_BITS) - 1 > USER_TOP - vaddr) {
+        userError("X64PML4 MapRange: Mapping address too high.");
+        current_syscall_error.type = seL4_InvalidArgument;
+        current_syscall_error.invalidArgumentNumber = 4;
+
+        return EXCEPTION_SYSCALL_ERROR;
+    }
+
+    for (i = 0; i < numFrames; i++) {
+        cap_t frameCap = window_ret.window[i].cap;
+        vptr_t va = vaddr + (i << PAGE_BITS);
+
+        if (cap_get_capType(frameCap) != cap_frame_cap ||
+            cap_frame_cap_get_capFSize(frameCap) != X86_SmallPage) {
+            userError("X64PML4 MapRange: Slot #%lu is not a small frame cap.",
+                      (long)(nodeOffset + i));
+            current_syscall_error.type = seL4_InvalidCapability;
+            current_syscall_error.invalidCapNumber = 1;
+
+            return EXCEPTION_SYSCALL_ERROR;
+        }
+
+        /* A frame that is already mapped may only be remapped in place,
+         * with the same errors as for X86PageMap */
+        if (cap_frame_cap_get_capFMappedASID(frameCap) != asidInvalid) {
+            if (cap_frame_cap_get_capFMappedASID(frameCap) != asid) {
+                userError("X64PML4 MapRange: Frame in slot #%lu belongs to a different address space.",
+                          (long)(nodeOffset + i));
+                current_syscall_error.type = seL4_InvalidCapability;
+                current_syscall_error.invalidCapNumber = 1;
+
+                return EXCEPTION_SYSCALL_ERROR;
+            }
+
+            if (cap_frame_cap_get_capFMapType(frameCap) != X86_MappingVSpace) {
+                userError("X64PML4 MapRange: Frame in slot #%lu has a different mapping type.",
+                          (long)(nodeOffset + i));
+                current_syscall_error.type = seL4_IllegalOperation;
+
+                return EXCEPTION_SYSCALL_ERROR;
+            }
+
+            if (cap_frame_cap_get_capFMappedAddress(frameCap) != va) {
+                userError("X64PML4 MapRange: Frame in slot #%lu is mapped at a different address.",
+                          (long)(nodeOffset + i));
+                current_syscall_error.type = seL4_InvalidArgument;
+                current_syscall_error.invalidArgumentNumber = 4;
+
+                return EXCEPTION_SYSCALL_ERROR;
+            }
+        }
+
+        if (i == 0 || IS_ALIGNED(va, PT_INDEX_BITS + PAGE_BITS)) {
+            lu_ret = lookupPTSlot(vspace, va);
+            if (lu_ret.status != EXCEPTION_NONE) {
+                current_syscall_error.type = seL4_FailedLookup;
+                current_syscall_error.failedLookupWasSource = false;
+                /* current_lookup_fault will have been set by lookupPTSlot */
+                return EXCEPTION_SYSCALL_ERROR;
+            }
+        }
+    }
+
+    setThreadState(NODE_STATE(ksCurThread), ThreadState_Restart);
+    return performX64PML4InvocationMapRange(asid, vspace, window_ret.window, numFrames, vaddr,
+                                            rights, attr);
+}
+#endif /* CONFIG_FRAME_MAP_RANGE */
+
 exception_t decodeX86ModeMMUInvocation(
     word_t label,
     word_t length,
@@ -1414,8 +1710,12 @@ exception_t decodeX86ModeMMUInvocation(
     switch (cap_get_capType(cap)) {
 
     case cap_pml4_cap:
+#ifdef CONFIG_FRAME_MAP_RANGE
+        return decodeX64PML4Invocation(label, length, cte, cap, buffer);
+#else
         current_syscall_error.type = seL4_IllegalOperation;
         return EXCEPTION_SYSCALL_ERROR;
+#endif
 
     case cap_pdpt_cap:
         return decodeX64PDPTInvocation(label, length, cte, cap, buffer);
@@ -1529,7 +1829,7 @@ exception_t decodeX86ModeMapPage(word_t label, vm_page_size_t page_size, cte_t *
     fail("Invalid Page type");
 }
 
-#ifdef CONFIG_PRINTING
+#if defined(CONFIG_PRINTING) || CONFIG_BENCHMARK_SAMPLE_PROFILE_USER_FRAMES > 0
 typedef struct readWordFromVSpace_ret {
     exception_t status;
     word_t value;
@@ -1573,6 +1873,11 @@ static readWordFromVSpace_ret_t readWordFromVSpace(vspace_root_t *vspace, word_t
         }
     }
 
+    /* Device frames may lie outside the kernel window */
+    if (paddr >= PADDR_TOP) {
+        ret.status = EXCEPTION_LOOKUP_FAULT;
+        return ret;
+    }
 
     kernel_vaddr = (word_t)paddr_to_pptr(paddr);
     value = (word_t *)(kernel_vaddr + offset);
@@ -1580,7 +1885,51 @@ static readWordFromVSpace_ret_t readWordFromVSpace(vspace_root_t *vspace, word_t
     ret.value = *value;
     return ret;
 }
+#endif /* CONFIG_PRINTING || CONFIG_BENCHMARK_SAMPLE_PROFILE_USER_FRAMES > 0 */
+
+#if CONFIG_BENCHMARK_SAMPLE_PROFILE_USER_FRAMES > 0
+void benchmark_arch_sample_user_frames(tcb_t *tptr, word_t *frames)
+{
+    cap_t threadRoot;
+    vspace_root_t *vspace_root;
+    readWordFromVSpace_ret_t next, ret;
+    word_t fp;
+
+#ifdef CONFIG_VTX
+    /* The registers of a thread running a guest are not user-level registers */
+    if (tptr->tcbArch.tcbVCPU) {
+        return;
+    }
+#endif
+
+    threadRoot = TCB_PTR_CTE_PTR(tptr, tcbVTable)->cap;
+    if (cap_get_capType(threadRoot) != cap_pml4_cap) {
+        return;
+    }
+    vspace_root = (vspace_root_t *)pptr_of_cap(threadRoot);
+
+    /* Each frame holds the previous frame pointer followed by the return
+     * address, and frames further up the stack have higher addresses */
+    fp = getRegister(tptr, RBP);
+    for (unsigned int i = 0; i < CONFIG_BENCHMARK_SAMPLE_PROFILE_USER_FRAMES; i++) {
+        if (fp == 0 || !IS_ALIGNED(fp, seL4_WordSizeBits + 1) || fp >= USER_TOP) {
+            return;
+        }
+        next = readWordFromVSpace(vspace_root, fp);
+        ret = readWordFromVSpace(vspace_root, fp + sizeof(word_t));
+        if (next.status != EXCEPTION_NONE || ret.status != EXCEPTION_NONE) {
+            return;
+        }
+        frames[i] = ret.value;
+        if (next.value <= fp) {
+            return;
+        }
+        fp = next.value;
+    }
+}
+#endif /* CONFIG_BENCHMARK_SAMPLE_PROFILE_USER_FRAMES > 0 */
 
+#ifdef CONFIG_PRINTING
 void Arch_userStackTrace(tcb_t *tptr)
 {
     cap_t threadRoot;
@@ -21,6 +21,12 @@ void Mode_handleRemoteCall(IpiModeRemoteCall_t call, word_t arg0, word_t arg1, w
         invalidateLocalASID((vspace_root_t *)arg0, arg1);
         break;
 
+#ifdef CONFIG_X86_RANGE_TLB_INVALIDATION
+    case IpiRemoteCall_InvalidateTranslationList:
+        invalidateLocalTranslationList((tlb_flush_list_t *)arg0, arg1);
+        break;
+#endif
+
     default:
         fail("Invalid remote call");
     }
@@ -13,7 +13,87 @@
 timestamp_t ksEntries[CONFIG_MAX_NUM_TRACE_POINTS];
 bool_t ksStarted[CONFIG_MAX_NUM_TRACE_POINTS];
 timestamp_t ksExit;
-seL4_Word ksLogIndex = 0;
-seL4_Word ksLogIndexFinalized = 0;
 
 #endif /* CONFIG_MAX_NUM_TRACE_POINTS > 0 */
+
+#ifdef CONFIG_BENCHMARK_SAMPLE_PROFILE
+
+#include <benchmark/benchmark_sample.h>
+#include <arch/benchmark.h>
+#include <arch/machine.h>
+#include <arch/kernel/apic.h>
+
+/* General purpose counter 0 counts unhalted core cycles and overflows after
+ * every sampling period */
+#define SAMPLE_COUNTER 0
+#define PERFEVTSEL_UNHALTED_CORE_CYCLES 0x3c
+#define PERFEVTSEL_USR BIT(16)
+#define PERFEVTSEL_OS BIT(17)
+#define PERFEVTSEL_INT BIT(20)
+#define PERFEVTSEL_EN BIT(22)
+
+/* Architectural performance monitoring CPUID leaf */
+#define CPUID_PERFMON_LEAF 0xa
+#define CPUID_PERFMON_VERSION(eax) ((eax) & 0xff)
+#define CPUID_PERFMON_COUNTERS(eax) (((eax) >> 8) & 0xff)
+#define CPUID_PERFMON_EVENTS(eax) (((eax) >> 24) & 0xff)
+/* Set in ebx if the unhalted core cycles event is not available */
+#define CPUID_PERFMON_NO_CORE_CYCLES BIT(0)
+
+compile_assert(sample_profile_period_sane,
+               CONFIG_BENCHMARK_SAMPLE_PROFILE_PERIOD > 0 && CONFIG_BENCHMARK_SAMPLE_PROFILE_PERIOD < BIT(31))
+
+static inline void x86_start_sample_period(void)
+{
+    /* Writes to IA32_PMC0 sign extend bit 31 of the value */
+    x86_wrmsr(IA32_PMC0_MSR, -(uint64_t)CONFIG_BENCHMARK_SAMPLE_PROFILE_PERIOD);
+}
+
+static inline void x86_unmask_sample_interrupt(void)
+{
+    apic_write_reg(
+        APIC_LVT_PERF_CNTR,
+        apic_lvt_new(
+            0,      /* timer_mode      */
+            0,      /* masked          */
+            0,      /* trigger_mode    */
+            0,      /* remote_irr      */
+            0,      /* pin_polarity    */
+            0,      /* delivery_status */
+            0,      /* delivery_mode   */
+            int_pmu /* vector          */
+        ).words[0]
+    );
+}
+
+BOOT_CODE bool_t x86_init_pmu_sampling(void)
+{
+    uint32_t eax = x86_cpuid_eax(CPUID_PERFMON_LEAF, 0);
+    uint32_t ebx = x86_cpuid_ebx(CPUID_PERFMON_LEAF, 0);
+
+    if (CPUID_PERFMON_VERSION(eax) < 2 || CPUID_PERFMON_COUNTERS(eax) == 0 ||
+        CPUID_PERFMON_EVENTS(eax) == 0 || (ebx & CPUID_PERFMON_NO_CORE_CYCLES)) {
+        printf("CPU does not count unhalted core cycles, sampling is not possible\n");
+        return false;
+    }
+
+    x86_wrmsr(IA32_PERFEVTSEL0_MSR, 0);
+    x86_start_sample_period();
+    x86_wrmsr(IA32_PERFEVTSEL0_MSR, PERFEVTSEL_UNHALTED_CORE_CYCLES | PERFEVTSEL_USR |
+              PERFEVTSEL_OS | PERFEVTSEL_INT | PERFEVTSEL_EN);
+    x86_unmask_sample_interrupt();
+    x86_wrmsr(IA32_PERF_GLOBAL_CTRL_MSR, x86_rdmsr(IA32_PERF_GLOBAL_CTRL_MSR) | BIT(SAMPLE_COUNTER));
+
+    return true;
+}
+
+void x86_handle_sample_overflow(void)
+{
+    x86_wrmsr(IA32_PERF_GLOBAL_OVF_CTRL_MSR, BIT(SAMPLE_COUNTER));
+    benchmark_sample_record();
+    x86_start_sample_period();
+    /* The local APIC masks the entry when it delivers the interrupt */
+    x86_unmask_sample_interrupt();
+}
+
+#endif /* CONFIG_BENCHMARK_SAMPLE_PROFILE */
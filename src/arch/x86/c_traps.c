@@ -13,6 +13,7 @@
 #include <arch/object/vcpu.h>
 #include <api/syscall.h>
 #include <sel4/arch/vmenter.h>
+#include <plat/machine/intel-vtd.h>
 
 #include <benchmark/benchmark_track.h>
 #include <benchmark/benchmark_utilisation.h>
@@ -137,6 +138,12 @@ void NORETURN slowpath(syscall_t syscall)
         handleSyscall(syscall);
     }
 
+#ifdef CONFIG_IOMMU_QUEUED_INVALIDATION
+    /* IOMMU invalidations queued by this syscall must complete before the
+     * kernel lock is released and user level can reuse the unmapped memory */
+    vtd_flush_invalidations();
+#endif
+
     restore_user_context();
     UNREACHABLE();
 }
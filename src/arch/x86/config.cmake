@@ -104,6 +104,19 @@ config_string(
     UNQUOTE
 )
 
+config_option(
+    KernelIOMMUQueuedInvalidation IOMMU_QUEUED_INVALIDATION
+    "Use the VT-d queued invalidation interface instead of the register based one. \
+    Unmapping an IO page queues a page-selective IOTLB invalidation and removing an IO \
+    page table or context entry queues a domain-selective one. All invalidations queued \
+    during a kernel entry are submitted together and waited on once before returning to \
+    user level. Falls back to global register based invalidation on IOMMUs that do not \
+    report queued invalidation support."
+    DEFAULT OFF
+    DEPENDS "KernelIOMMU;NOT KernelVerificationBuild"
+    DEFAULT_DISABLED OFF
+)
+
 config_string(
     KernelMaxVPIDs MAX_VPIDS
     "The kernel maintains a mapping of 16-bit VPIDs to VCPUs. This option should be \
@@ -128,6 +141,26 @@ config_option(
     DEPENDS "KernelSel4ArchX86_64"
     DEFAULT_DISABLED OFF
 )
+config_option(
+    KernelX86RangeTLBInvalidation X86_RANGE_TLB_INVALIDATION
+    "When unmapping a paging structure, invalidate the translations of the pages mapped \
+    through it individually instead of flushing the whole PCID, as long as there are at \
+    most KernelX86RangeTLBInvalidationMaxPages of them."
+    DEFAULT OFF
+    DEPENDS "KernelSel4ArchX86_64;NOT KernelVerificationBuild"
+    DEFAULT_DISABLED OFF
+)
+config_string(
+    KernelX86RangeTLBInvalidationMaxPages X86_RANGE_TLB_INVALIDATION_MAX_PAGES
+    "Maximum number of individual translations invalidated when unmapping a paging structure \
+    before falling back to flushing the whole PCID. This also bounds the number of page \
+    tables that are scanned for mappings. The addresses are collected on the kernel stack \
+    and must fit into an eighth of it, see KernelStackBits."
+    DEFAULT 16
+    UNQUOTE
+    DEPENDS "KernelX86RangeTLBInvalidation"
+    UNDEF_DISABLED
+)
 
 config_choice(
     KernelSyscall
@@ -42,6 +42,10 @@ BOOT_CODE static void init_irqs(cap_t root_cnode_cap)
 #ifdef CONFIG_IOMMU
         } else if (i == irq_iommu) {
             setIRQState(IRQReserved, i);
+#endif
+#ifdef CONFIG_BENCHMARK_SAMPLE_PROFILE
+        } else if (i == irq_pmu) {
+            setIRQState(IRQReserved, i);
 #endif
         } else if (i == 2 && config_set(CONFIG_IRQ_PIC)) {
             /* cascaded legacy PIC */
@@ -416,6 +420,12 @@ BOOT_CODE bool_t init_cpu(
         enablePMCUser();
     }
 
+#ifdef CONFIG_BENCHMARK_SAMPLE_PROFILE
+    if (!x86_init_pmu_sampling()) {
+        return false;
+    }
+#endif
+
 #ifdef CONFIG_VTX
     /* initialise Intel VT-x extensions */
     if (!vtx_init()) {
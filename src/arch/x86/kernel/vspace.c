@@ -9,6 +9,7 @@
 #include <machine/io.h>
 #include <kernel/boot.h>
 #include <model/statedata.h>
+#include <benchmark/benchmark_preemption.h>
 #include <arch/kernel/vspace.h>
 #include <arch/api/invocation.h>
 #include <arch/kernel/tlb_bitmap.h>
@@ -36,6 +37,9 @@ static exception_t performPageGetAddress(void *vbase_ptr, bool_t call)
 
 void deleteASIDPool(asid_t asid_base, asid_pool_t *pool)
 {
+#ifdef CONFIG_BENCHMARK_PREEMPTION_LATENCY
+    word_t prev_op = benchmark_preemption_op(BENCHMARK_PREEMPTION_OP_DELETE_ASID_POOL);
+#endif
     /* Haskell error: "ASID pool's base must be aligned" */
     assert(IS_ALIGNED(asid_base, asidLowBits));
 
@@ -50,6 +54,9 @@ void deleteASIDPool(asid_t asid_base, asid_pool_t *pool)
         x86KSASIDTable[asid_base >> asidLowBits] = NULL;
         setVMRoot(NODE_STATE(ksCurThread));
     }
+#ifdef CONFIG_BENCHMARK_PREEMPTION_LATENCY
+    benchmark_preemption_op(prev_op);
+#endif
 }
 
 exception_t performASIDControlInvocation(void *frame, cte_t *slot, cte_t *parent, asid_t asid_base)
@@ -692,13 +699,31 @@ vm_rights_t CONST maskVMRights(vm_rights_t vm_rights, seL4_CapRights_t cap_right
 
 void flushTable(vspace_root_t *vspace, word_t vptr, pte_t *pt, asid_t asid)
 {
+#ifndef CONFIG_X86_RANGE_TLB_INVALIDATION
     word_t i;
+#endif
     cap_t        threadRoot;
 
     assert(IS_ALIGNED(vptr, PT_INDEX_BITS + PAGE_BITS));
 
     /* check if page table belongs to current address space */
     threadRoot = TCB_PTR_CTE_PTR(NODE_STATE(ksCurThread), tcbVTable)->cap;
+#ifdef CONFIG_X86_RANGE_TLB_INVALIDATION
+    if (config_set(CONFIG_SUPPORT_PCID) || (isValidNativeRoot(threadRoot)
+                                            && (vspace_root_t *)pptr_of_cap(threadRoot) == vspace)) {
+        tlb_flush_list_t list;
+
+        list.count = 0;
+        list.tables = 0;
+        /* invalidate the collected mappings with a single remote call, or
+         * the whole PCID if there are too many of them */
+        if (collectTableMappings(&list, pt, vptr)) {
+            invalidateTranslationList(&list, asid, SMP_TERNARY(tlb_bitmap_get(vspace), 0));
+        } else {
+            hwASIDInvalidate(asid, vspace);
+        }
+    }
+#else
     /* find valid mappings */
     for (i = 0; i < BIT(PT_INDEX_BITS); i++) {
         if (pte_get_present(pt[i])) {
@@ -709,6 +734,7 @@ void flushTable(vspace_root_t *vspace, word_t vptr, pte_t *pt, asid_t asid)
             }
         }
     }
+#endif
 }
 
 
@@ -51,6 +51,20 @@ vtd_rte_t *x86KSvtdRootTable;
 uint32_t x86KSnumIOPTLevels;
 uint32_t x86KSnumIODomainIDBits;
 uint32_t x86KSFirstValidIODomain;
+#ifdef CONFIG_IOMMU_QUEUED_INVALIDATION
+/* Whether every IOMMU is using its invalidation queue, and whether they all
+ * support page-selective IOTLB invalidation */
+bool_t x86KSvtdQueuedInvalidation;
+bool_t x86KSvtdPageSelectiveInvalidation;
+/* One page of invalidation descriptors per IOMMU, followed by one page of
+ * wait descriptor status words */
+uint64_t *x86KSvtdInvQueue;
+uint32_t *x86KSvtdInvStatus;
+/* Descriptors up to head have completed, descriptors between head and tail
+ * are queued but not yet submitted to the hardware */
+word_t x86KSvtdInvQueueHead;
+word_t x86KSvtdInvQueueTail;
+#endif
 #endif
 
 #ifdef CONFIG_VTX
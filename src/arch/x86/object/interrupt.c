@@ -19,6 +19,9 @@ void Arch_irqStateInit(void)
         if (i == irq_timer
 #ifdef CONFIG_IOMMU
             || i == irq_iommu
+#endif
+#ifdef CONFIG_BENCHMARK_SAMPLE_PROFILE
+            || i == irq_pmu
 #endif
            ) {
             x86KSIRQState[i] = x86_irq_state_irq_reserved_new();
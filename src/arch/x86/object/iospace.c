@@ -11,6 +11,7 @@
 #include <api/syscall.h>
 #include <machine/io.h>
 #include <kernel/thread.h>
+#include <kernel/cspace.h>
 #include <arch/api/invocation.h>
 #include <arch/object/iospace.h>
 #include <arch/model/statedata.h>
@@ -123,6 +124,9 @@ void unmapVTDContextEntry(cap_t cap)
 {
     vtd_cte_t *cte = lookup_vtd_context_slot(cap);
     assert(cte != 0);
+#ifdef CONFIG_IOMMU_QUEUED_INVALIDATION
+    uint16_t domain_id = vtd_cte_ptr_get_did(cte);
+#endif
     *cte = vtd_cte_new(
                0,
                false,
@@ -133,7 +137,12 @@ void unmapVTDContextEntry(cap_t cap)
            );
 
     flushCacheRange(cte, VTD_CTE_SIZE_BITS);
+#ifdef CONFIG_IOMMU_QUEUED_INVALIDATION
+    vtd_invalidate_context_domain(domain_id);
+    vtd_invalidate_iotlb_domain(domain_id);
+#else
     invalidate_iotlb();
+#endif
     setThreadState(NODE_STATE(ksCurThread), ThreadState_Restart);
     return;
 }
@@ -412,6 +421,9 @@ void deleteIOPageTable(cap_t io_pt_cap)
         }
 
         vtd_pte = (vtd_pte_t *)paddr_to_pptr(vtd_cte_ptr_get_asr(vtd_context_slot));
+#ifdef CONFIG_IOMMU_QUEUED_INVALIDATION
+        uint16_t domain_id = vtd_cte_ptr_get_did(vtd_context_slot);
+#endif
 
         if (level == 0) {
             /* if we have been overmapped or something */
@@ -427,6 +439,9 @@ void deleteIOPageTable(cap_t io_pt_cap)
                                     0       /* Present            */
                                 );
             flushCacheRange(vtd_context_slot, VTD_CTE_SIZE_BITS);
+#ifdef CONFIG_IOMMU_QUEUED_INVALIDATION
+            vtd_invalidate_context_domain(domain_id);
+#endif
         } else {
             io_address = cap_io_page_table_cap_get_capIOPTMappedAddress(io_pt_cap);
             lu_ret = lookupIOPTSlot_resolve_levels(vtd_pte, io_address >> PAGE_BITS, level - 1, level - 1);
@@ -446,7 +461,11 @@ void deleteIOPageTable(cap_t io_pt_cap)
                                );
             flushCacheRange(lu_ret.ioptSlot, VTD_PTE_SIZE_BITS);
         }
+#ifdef CONFIG_IOMMU_QUEUED_INVALIDATION
+        vtd_invalidate_iotlb_domain(domain_id);
+#else
         invalidate_iotlb();
+#endif
     }
 }
 
@@ -483,7 +502,11 @@ void unmapIOPage(cap_t cap)
                        );
 
     flushCacheRange(lu_ret.ioptSlot, VTD_PTE_SIZE_BITS);
+#ifdef CONFIG_IOMMU_QUEUED_INVALIDATION
+    vtd_invalidate_iotlb_page(vtd_cte_ptr_get_did(vtd_context_slot), io_address);
+#else
     invalidate_iotlb();
+#endif
 }
 
 exception_t performX86IOUnMapInvocation(cap_t cap, cte_t *ctSlot)
@@ -497,9 +520,195 @@ exception_t performX86IOUnMapInvocation(cap_t cap, cte_t *ctSlot)
     return EXCEPTION_NONE;
 }
 
-exception_t decodeX86IOSpaceInvocation(word_t invLabel, cap_t cap)
+#ifdef CONFIG_FRAME_MAP_RANGE
+/* Flush a run of IO page table entries from the CPU cache with one pair of
+ * fences instead of one pair per entry */
+static void flushIOPTERange(vtd_pte_t *start, vtd_pte_t *end)
 {
-    userError("IOSpace capability has no invocations");
+    word_t v;
+
+    if (start >= end) {
+        return;
+    }
+
+    x86_mfence();
+    for (v = ROUND_DOWN((word_t)start, x86KScacheLineSizeBits);
+         v < (word_t)end;
+         v += BIT(x86KScacheLineSizeBits)) {
+        flushCacheLine((void *)v);
+    }
+    x86_mfence();
+}
+
+static inline vtd_pte_t makeIOPTE(cap_t frameCap, seL4_CapRights_t dma_cap_rights_mask)
+{
+    vm_rights_t frame_cap_rights = cap_frame_cap_get_capFVMRights(frameCap);
+    bool_t write = seL4_CapRights_get_capAllowWrite(dma_cap_rights_mask) && (frame_cap_rights == VMReadWrite);
+    bool_t read = seL4_CapRights_get_capAllowRead(dma_cap_rights_mask) && (frame_cap_rights != VMKernelOnly);
+
+    return vtd_pte_new(pptr_to_paddr((void *)cap_frame_cap_get_capFBasePtr(frameCap)), !!write, !!read);
+}
+
+static exception_t performX86IOSpaceInvocationMapRange(vtd_pte_t *vtd_pte, uint32_t pci_request_id,
+                                                       cte_t *window, word_t numFrames, word_t io_address,
+                                                       seL4_CapRights_t dma_cap_rights_mask)
+{
+    vtd_pte_t *runStart = NULL;
+    vtd_pte_t *ioptSlot = NULL;
+    word_t i;
+
+    for (i = 0; i < numFrames; i++) {
+        word_t addr = io_address + (i << PAGE_BITS);
+        cap_t cap = window[i].cap;
+
+        /* Only walk the IO page tables when entering a new IO page table */
+        if (i == 0 || IS_ALIGNED(addr, VTD_PT_INDEX_BITS + PAGE_BITS)) {
+            flushIOPTERange(runStart, ioptSlot);
+            ioptSlot = lookupIOPTSlot(vtd_pte, addr).ioptSlot;
+            runStart = ioptSlot;
+        }
+
+        *ioptSlot = makeIOPTE(cap, dma_cap_rights_mask);
+        ioptSlot++;
+
+        cap = cap_frame_cap_set_capFMapType(cap, X86_MappingIOSpace);
+        cap = cap_frame_cap_set_capFMappedASID(cap, pci_request_id);
+        cap = cap_frame_cap_set_capFMappedAddress(cap, addr);
+        window[i].cap = cap;
+    }
+    flushIOPTERange(runStart, ioptSlot);
+
+    /* Only empty entries were written, which the IOMMU does not cache, so
+     * no IOTLB invalidation is required, as for X86PageMapIO */
+    return EXCEPTION_NONE;
+}
+
+static exception_t decodeX86IOSpaceMapRange(word_t length, cap_t cap, word_t *buffer)
+{
+    word_t                 nodeDepth, nodeOffset, numFrames, io_address, i;
+    cptr_t                 nodeIndex;
+    seL4_CapRights_t       dma_cap_rights_mask;
+    uint32_t               pci_request_id;
+    vtd_cte_t             *vtd_context_slot;
+    vtd_pte_t             *vtd_pte;
+    vtd_pte_t             *ioptSlot = NULL;
+    lookupSlotWindow_ret_t window_ret;
+    lookupIOPTSlot_ret_t   lu_ret;
+
+    if (length < 6 || current_extra_caps.excaprefs[0] == NULL) {
+        userError("X86IOSpace MapRange: Truncated message.");
+        current_syscall_error.type = seL4_TruncatedMessage;
+        return EXCEPTION_SYSCALL_ERROR;
+    }
+
+    nodeIndex           = getSyscallArg(0, buffer);
+    nodeDepth           = getSyscallArg(1, buffer);
+    nodeOffset          = getSyscallArg(2, buffer);
+    numFrames           = getSyscallArg(3, buffer);
+    io_address          = getSyscallArg(4, buffer);
+    dma_cap_rights_mask = rightsFromWord(getSyscallArg(5, buffer));
+
+    pci_request_id = cap_io_space_cap_get_capPCIDevice(cap);
+    if (pci_request_id == asidInvalid) {
+        userError("X86IOSpace MapRange: Invalid PCI device.");
+        current_syscall_error.type = seL4_InvalidCapability;
+        current_syscall_error.invalidCapNumber = 0;
+        return EXCEPTION_SYSCALL_ERROR;
+    }
+
+    vtd_context_slot = lookup_vtd_context_slot(cap);
+    if (!vtd_cte_ptr_get_present(vtd_context_slot)) {
+        /* 1st Level Page Table is not installed */
+        current_syscall_error.type = seL4_FailedLookup;
+        current_syscall_error.failedLookupWasSource = false;
+        return EXCEPTION_SYSCALL_ERROR;
+    }
+    vtd_pte = (vtd_pte_t *)paddr_to_pptr(vtd_cte_ptr_get_asr(vtd_context_slot));
+
+    window_ret = lookupSourceWindow(current_extra_caps.excaprefs[0]->cap, nodeIndex, nodeDepth,
+                                    nodeOffset, numFrames, CONFIG_MAP_RANGE_MAX_FRAMES);
+    if (window_ret.status != EXCEPTION_NONE) {
+        userError("X86IOSpace MapRange: Invalid frame window.");
+        return window_ret.status;
+    }
+
+    if (!IS_ALIGNED(io_address, PAGE_BITS)) {
+        current_syscall_error.type = seL4_AlignmentError;
+        return EXCEPTION_SYSCALL_ERROR;
+    }
+
+    /* numFrames is bounded by CONFIG_MAP_RANGE_MAX_FRAMES, so the range
+     * cannot overflow. The IO page tables only translate the low address
+     * bits, so the range must not extend past them. */
+    if ((io_address >> PAGE_BITS) + numFrames > BIT(VTD_PT_INDEX_BITS * x86KSnumIOPTLevels)) {
+        userError("X86IOSpace MapRange: IO address range too high.");
+        current_syscall_error.type = seL4_InvalidArgument;
+        current_syscall_error.invalidArgumentNumber = 4;
+        return EXCEPTION_SYSCALL_ERROR;
+    }
+
+    for (i = 0; i < numFrames; i++) {
+        cap_t frameCap = window_ret.window[i].cap;
+        word_t addr = io_address + (i << PAGE_BITS);
+
+        if (cap_get_capType(frameCap) != cap_frame_cap ||
+            cap_frame_cap_get_capFSize(frameCap) != X86_SmallPage) {
+            userError("X86IOSpace MapRange: Slot #%lu is not a small frame cap.",
+                      (long)(nodeOffset + i));
+            current_syscall_error.type = seL4_InvalidCapability;
+            current_syscall_error.invalidCapNumber = 1;
+            return EXCEPTION_SYSCALL_ERROR;
+        }
+
+        if (cap_frame_cap_get_capFMappedASID(frameCap) != asidInvalid) {
+            userError("X86IOSpace MapRange: Frame in slot #%lu is already mapped.",
+                      (long)(nodeOffset + i));
+            current_syscall_error.type = seL4_InvalidCapability;
+            current_syscall_error.invalidCapNumber = 1;
+            return EXCEPTION_SYSCALL_ERROR;
+        }
+
+        vtd_pte_t iopte = makeIOPTE(frameCap, dma_cap_rights_mask);
+        if (!vtd_pte_get_write(iopte) && !vtd_pte_get_read(iopte)) {
+            userError("X86IOSpace MapRange: No rights for the frame in slot #%lu.",
+                      (long)(nodeOffset + i));
+            current_syscall_error.type = seL4_InvalidArgument;
+            current_syscall_error.invalidArgumentNumber = 5;
+            return EXCEPTION_SYSCALL_ERROR;
+        }
+
+        if (i == 0 || IS_ALIGNED(addr, VTD_PT_INDEX_BITS + PAGE_BITS)) {
+            lu_ret = lookupIOPTSlot(vtd_pte, addr);
+            if (lu_ret.status != EXCEPTION_NONE || lu_ret.level != 0) {
+                current_syscall_error.type = seL4_FailedLookup;
+                current_syscall_error.failedLookupWasSource = false;
+                return EXCEPTION_SYSCALL_ERROR;
+            }
+            ioptSlot = lu_ret.ioptSlot;
+        }
+
+        if (vtd_pte_ptr_get_addr(ioptSlot) != 0) {
+            current_syscall_error.type = seL4_DeleteFirst;
+            return EXCEPTION_SYSCALL_ERROR;
+        }
+        ioptSlot++;
+    }
+
+    setThreadState(NODE_STATE(ksCurThread), ThreadState_Restart);
+    return performX86IOSpaceInvocationMapRange(vtd_pte, pci_request_id, window_ret.window, numFrames,
+                                               io_address, dma_cap_rights_mask);
+}
+#endif /* CONFIG_FRAME_MAP_RANGE */
+
+exception_t decodeX86IOSpaceInvocation(word_t invLabel, word_t length, cap_t cap, word_t *buffer)
+{
+#ifdef CONFIG_FRAME_MAP_RANGE
+    if (invLabel == X86IOSpaceMapRange) {
+        return decodeX86IOSpaceMapRange(length, cap, buffer);
+    }
+#endif
+
+    userError("X86IOSpace: Illegal operation.");
     current_syscall_error.type = seL4_IllegalOperation;
     return EXCEPTION_SYSCALL_ERROR;
 }
@@ -521,7 +521,7 @@ exception_t Arch_decodeInvocation(
         return decodeX86PortInvocation(invLabel, length, cptr, slot, cap, call, buffer);
 #ifdef CONFIG_IOMMU
     case cap_io_space_cap:
-        return decodeX86IOSpaceInvocation(invLabel, cap);
+        return decodeX86IOSpaceInvocation(invLabel, length, cap, buffer);
     case cap_io_page_table_cap:
         return decodeX86IOPTInvocation(invLabel, length, slot, cap, buffer);
 #endif
@@ -452,7 +452,12 @@ void vcpu_init(vcpu_t *vcpu)
     // of a VM. When performance counters are supported this host state
     // needs to be updated on VM entry
     if (vmx_feature_load_perf_global_ctrl) {
+#ifdef CONFIG_BENCHMARK_SAMPLE_PROFILE
+        /* Keep the sampling counter running in the kernel */
+        vmwrite(VMX_HOST_PERF_GLOBAL_CTRL, x86_rdmsr(IA32_PERF_GLOBAL_CTRL_MSR));
+#else
         vmwrite(VMX_HOST_PERF_GLOBAL_CTRL, 0);
+#endif
     }
     vmwrite(VMX_HOST_CR0, read_cr0());
     vmwrite(VMX_HOST_CR4, read_cr4());
@@ -752,11 +757,8 @@ static exception_t decodeDisableIOPort(cap_t cap, word_t length, word_t *buffer)
     return invokeDisableIOPort(vcpu, low, high);
 }
 
-static exception_t invokeWriteVMCS(vcpu_t *vcpu, bool_t call, word_t *buffer, word_t field, word_t value)
+static void writeVMCSField(vcpu_t *vcpu, word_t field, word_t value)
 {
-    tcb_t *thread;
-    thread = NODE_STATE(ksCurThread);
-
     if (ARCH_NODE_STATE(x86KSCurrentVCPU) != vcpu) {
         switchVCPU(vcpu);
     }
@@ -775,6 +777,14 @@ static exception_t invokeWriteVMCS(vcpu_t *vcpu, bool_t call, word_t *buffer, wo
         break;
     }
     vmwrite(field, value);
+}
+
+static exception_t invokeWriteVMCS(vcpu_t *vcpu, bool_t call, word_t *buffer, word_t field, word_t value)
+{
+    tcb_t *thread;
+    thread = NODE_STATE(ksCurThread);
+
+    writeVMCSField(vcpu, field, value);
 
     if (call) {
         setRegister(thread, badgeRegister, 0);
@@ -786,19 +796,10 @@ static exception_t invokeWriteVMCS(vcpu_t *vcpu, bool_t call, word_t *buffer, wo
     return EXCEPTION_NONE;
 }
 
-static exception_t decodeWriteVMCS(cap_t cap, word_t length, bool_t call, word_t *buffer)
+/* Whether user level may write field of the VMCS. Bits of value that are fixed
+ * by the hardware or required by the kernel are set or cleared. */
+static bool_t validateWriteVMCSField(word_t field, word_t *value)
 {
-    word_t field;
-    word_t value;
-
-    if (length < 2) {
-        userError("VCPU WriteVMCS: Not enough arguments.");
-        current_syscall_error.type = seL4_IllegalOperation;
-        return EXCEPTION_SYSCALL_ERROR;
-    }
-
-    field = getSyscallArg(0, buffer);
-    value = getSyscallArg(1, buffer);
     switch (field) {
     case VMX_GUEST_RIP:
     case VMX_GUEST_RSP:
@@ -866,24 +867,43 @@ static exception_t decodeWriteVMCS(cap_t cap, word_t length, bool_t call, word_t
     case VMX_CONTROL_ENTRY_EXCEPTION_ERROR_CODE:
         break;
     case VMX_CONTROL_PIN_EXECUTION_CONTROLS:
-        value = applyFixedBits(value, pin_control_high, pin_control_low);
+        *value = applyFixedBits(*value, pin_control_high, pin_control_low);
         break;
     case VMX_CONTROL_PRIMARY_PROCESSOR_CONTROLS:
-        value = applyFixedBits(value, primary_control_high, primary_control_low);
+        *value = applyFixedBits(*value, primary_control_high, primary_control_low);
         break;
     case VMX_CONTROL_SECONDARY_PROCESSOR_CONTROLS:
-        value = applyFixedBits(value, secondary_control_high, secondary_control_low);
+        *value = applyFixedBits(*value, secondary_control_high, secondary_control_low);
         break;
     case VMX_CONTROL_EXIT_CONTROLS:
-        value = applyFixedBits(value, exit_control_high, exit_control_low);
+        *value = applyFixedBits(*value, exit_control_high, exit_control_low);
         break;
     case VMX_GUEST_CR0:
-        value = applyFixedBits(value, cr0_high, cr0_low);
+        *value = applyFixedBits(*value, cr0_high, cr0_low);
         break;
     case VMX_GUEST_CR4:
-        value = applyFixedBits(value, cr4_high, cr4_low);
+        *value = applyFixedBits(*value, cr4_high, cr4_low);
         break;
     default:
+        return false;
+    }
+    return true;
+}
+
+static exception_t decodeWriteVMCS(cap_t cap, word_t length, bool_t call, word_t *buffer)
+{
+    word_t field;
+    word_t value;
+
+    if (length < 2) {
+        userError("VCPU WriteVMCS: Not enough arguments.");
+        current_syscall_error.type = seL4_IllegalOperation;
+        return EXCEPTION_SYSCALL_ERROR;
+    }
+
+    field = getSyscallArg(0, buffer);
+    value = getSyscallArg(1, buffer);
+    if (!validateWriteVMCSField(field, &value)) {
         userError("VCPU WriteVMCS: Invalid field %lx.", (long)field);
         current_syscall_error.type = seL4_IllegalOperation;
         return EXCEPTION_SYSCALL_ERROR;
@@ -924,14 +944,9 @@ static exception_t invokeReadVMCS(vcpu_t *vcpu, word_t field, bool_t call, word_
     return EXCEPTION_NONE;
 }
 
-static exception_t decodeReadVMCS(cap_t cap, word_t length, bool_t call, word_t *buffer)
+/* Whether user level may read field of the VMCS */
+static bool_t validateReadVMCSField(word_t field)
 {
-    if (length < 1) {
-        userError("VCPU ReadVMCS: Not enough arguments.");
-        current_syscall_error.type = seL4_IllegalOperation;
-        return EXCEPTION_SYSCALL_ERROR;
-    }
-    word_t field = getSyscallArg(0, buffer);
     switch (field) {
     case VMX_GUEST_RIP:
     case VMX_GUEST_RSP:
@@ -1014,8 +1029,21 @@ static exception_t decodeReadVMCS(cap_t cap, word_t length, bool_t call, word_t
     case VMX_GUEST_CR0:
     case VMX_GUEST_CR3:
     case VMX_GUEST_CR4:
-        break;
+        return true;
     default:
+        return false;
+    }
+}
+
+static exception_t decodeReadVMCS(cap_t cap, word_t length, bool_t call, word_t *buffer)
+{
+    if (length < 1) {
+        userError("VCPU ReadVMCS: Not enough arguments.");
+        current_syscall_error.type = seL4_IllegalOperation;
+        return EXCEPTION_SYSCALL_ERROR;
+    }
+    word_t field = getSyscallArg(0, buffer);
+    if (!validateReadVMCSField(field)) {
         userError("VCPU ReadVMCS: Invalid field %lx.", (long)field);
         current_syscall_error.type = seL4_IllegalOperation;
         return EXCEPTION_SYSCALL_ERROR;
@@ -1023,6 +1051,129 @@ static exception_t decodeReadVMCS(cap_t cap, word_t length, bool_t call, word_t
     return invokeReadVMCS(VCPU_PTR(cap_vcpu_cap_get_capVCPUPtr(cap)), field, call, buffer);
 }
 
+#ifdef CONFIG_VCPU_REG_BATCH
+/* Batch arguments are the count followed by seL4_VCPURegBatchSize (field,
+ * value) pairs, of which the first count are used. They are copied out of the
+ * message so that the reply can be written over it. */
+static exception_t decodeVMCSBatch(word_t length, word_t *buffer, word_t *count, word_t *fields, word_t *values)
+{
+    word_t i;
+
+    if (length < 1) {
+        userError("VCPU VMCS batch: Not enough arguments.");
+        current_syscall_error.type = seL4_TruncatedMessage;
+        return EXCEPTION_SYSCALL_ERROR;
+    }
+    *count = getSyscallArg(0, buffer);
+    if (*count > seL4_VCPURegBatchSize) {
+        userError("VCPU VMCS batch: Too many fields %lu.", (unsigned long)*count);
+        current_syscall_error.type = seL4_RangeError;
+        current_syscall_error.rangeErrorMin = 0;
+        current_syscall_error.rangeErrorMax = seL4_VCPURegBatchSize;
+        return EXCEPTION_SYSCALL_ERROR;
+    }
+    if (length < 1 + 2 * *count) {
+        userError("VCPU VMCS batch: Not enough arguments.");
+        current_syscall_error.type = seL4_TruncatedMessage;
+        return EXCEPTION_SYSCALL_ERROR;
+    }
+
+    for (i = 0; i < *count; i++) {
+        fields[i] = getSyscallArg(1 + 2 * i, buffer);
+        values[i] = getSyscallArg(2 + 2 * i, buffer);
+    }
+    return EXCEPTION_NONE;
+}
+
+/* Reply with the fields and the values that were read or written, padded with
+ * zeros to the size of seL4_X86_VMCSBatch */
+static void replyVMCSBatch(word_t count, word_t *fields, word_t *values)
+{
+    tcb_t *thread = NODE_STATE(ksCurThread);
+    word_t *ipcBuffer = lookupIPCBuffer(true, thread);
+    unsigned int length = 0;
+    word_t i;
+
+    setRegister(thread, badgeRegister, 0);
+    for (i = 0; i < seL4_VCPURegBatchSize; i++) {
+        setMR(thread, ipcBuffer, 2 * i, i < count ? fields[i] : 0);
+        length = setMR(thread, ipcBuffer, 2 * i + 1, i < count ? values[i] : 0);
+    }
+    setRegister(thread, msgInfoRegister, wordFromMessageInfo(
+                    seL4_MessageInfo_new(0, 0, 0, length)));
+}
+
+static exception_t invokeReadVMCSBatch(vcpu_t *vcpu, word_t count, word_t *fields, word_t *values, bool_t call)
+{
+    word_t i;
+
+    for (i = 0; i < count; i++) {
+        values[i] = readVMCSField(vcpu, fields[i]);
+    }
+    if (call) {
+        replyVMCSBatch(count, fields, values);
+    }
+    setThreadState(NODE_STATE(ksCurThread), ThreadState_Running);
+    return EXCEPTION_NONE;
+}
+
+static exception_t decodeReadVMCSBatch(cap_t cap, word_t length, bool_t call, word_t *buffer)
+{
+    word_t count, i;
+    word_t fields[seL4_VCPURegBatchSize];
+    word_t values[seL4_VCPURegBatchSize];
+    exception_t status;
+
+    status = decodeVMCSBatch(length, buffer, &count, fields, values);
+    if (status != EXCEPTION_NONE) {
+        return status;
+    }
+    for (i = 0; i < count; i++) {
+        if (!validateReadVMCSField(fields[i])) {
+            userError("VCPU ReadVMCSBatch: Invalid field %lx.", (long)fields[i]);
+            current_syscall_error.type = seL4_IllegalOperation;
+            return EXCEPTION_SYSCALL_ERROR;
+        }
+    }
+    return invokeReadVMCSBatch(VCPU_PTR(cap_vcpu_cap_get_capVCPUPtr(cap)), count, fields, values, call);
+}
+
+static exception_t invokeWriteVMCSBatch(vcpu_t *vcpu, word_t count, word_t *fields, word_t *values, bool_t call)
+{
+    word_t i;
+
+    for (i = 0; i < count; i++) {
+        writeVMCSField(vcpu, fields[i], values[i]);
+    }
+    if (call) {
+        replyVMCSBatch(count, fields, values);
+    }
+    setThreadState(NODE_STATE(ksCurThread), ThreadState_Running);
+    return EXCEPTION_NONE;
+}
+
+static exception_t decodeWriteVMCSBatch(cap_t cap, word_t length, bool_t call, word_t *buffer)
+{
+    word_t count, i;
+    word_t fields[seL4_VCPURegBatchSize];
+    word_t values[seL4_VCPURegBatchSize];
+    exception_t status;
+
+    status = decodeVMCSBatch(length, buffer, &count, fields, values);
+    if (status != EXCEPTION_NONE) {
+        return status;
+    }
+    for (i = 0; i < count; i++) {
+        if (!validateWriteVMCSField(fields[i], &values[i])) {
+            userError("VCPU WriteVMCSBatch: Invalid field %lx.", (long)fields[i]);
+            current_syscall_error.type = seL4_IllegalOperation;
+            return EXCEPTION_SYSCALL_ERROR;
+        }
+    }
+    return invokeWriteVMCSBatch(VCPU_PTR(cap_vcpu_cap_get_capVCPUPtr(cap)), count, fields, values, call);
+}
+#endif /* CONFIG_VCPU_REG_BATCH */
+
 static exception_t invokeSetTCB(vcpu_t *vcpu, tcb_t *tcb)
 {
     associateVcpuTcb(tcb, vcpu);
@@ -1105,6 +1256,12 @@ exception_t decodeX86VCPUInvocation(
         return decodeReadVMCS(cap, length, call, buffer);
     case X86VCPUWriteVMCS:
         return decodeWriteVMCS(cap, length, call, buffer);
+#ifdef CONFIG_VCPU_REG_BATCH
+    case X86VCPUReadVMCSBatch:
+        return decodeReadVMCSBatch(cap, length, call, buffer);
+    case X86VCPUWriteVMCSBatch:
+        return decodeWriteVMCSBatch(cap, length, call, buffer);
+#endif
     case X86VCPUEnableIOPort:
         return decodeEnableIOPort(cap, length, buffer);
     case X86VCPUDisableIOPort:
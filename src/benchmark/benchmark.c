@@ -11,8 +11,18 @@
 #include <types.h>
 #include <mode/machine.h>
 #include <benchmark/benchmark.h>
+#include <benchmark/benchmark_track.h>
+#include <benchmark/benchmark_sample.h>
+#include <benchmark/benchmark_sched.h>
+#include <benchmark/benchmark_irq.h>
 #include <benchmark/benchmark_utilisation.h>
+#include <benchmark/benchmark_fastpath.h>
+#include <benchmark/benchmark_preemption.h>
 
+#ifdef CONFIG_KERNEL_LOG_BUFFER
+seL4_Word ksLogIndex;
+seL4_Word ksLogIndexFinalized;
+#endif /* CONFIG_KERNEL_LOG_BUFFER */
 
 exception_t handle_SysBenchmarkFlushCaches(void)
 {
@@ -40,6 +50,23 @@ exception_t handle_SysBenchmarkResetLog(void)
     }
 
     ksLogIndex = 0;
+#ifdef CONFIG_BENCHMARK_TRACK_KERNEL_ENTRIES_RING
+    benchmark_track_ring_reset();
+#endif
+#ifdef CONFIG_BENCHMARK_TRACK_KERNEL_ENTRIES_HISTOGRAM
+    benchmark_track_histogram_reset();
+#endif
+#ifdef CONFIG_BENCHMARK_IRQ_LATENCY
+    benchmark_irq_latency_reset();
+#endif
+#ifdef CONFIG_BENCHMARK_SAMPLE_PROFILE
+    benchmark_sample_reset();
+    ksSampleProfileEnabled = true;
+#endif
+#ifdef CONFIG_BENCHMARK_SCHED_TRACE
+    benchmark_sched_reset();
+    ksSchedTraceEnabled = true;
+#endif
 #endif /* CONFIG_KERNEL_LOG_BUFFER */
 
 #ifdef CONFIG_BENCHMARK_TRACK_UTILISATION
@@ -51,6 +78,7 @@ exception_t handle_SysBenchmarkResetLog(void)
     NODE_STATE(benchmark_kernel_time) = 0;
     NODE_STATE(benchmark_kernel_number_entries) = 0;
     NODE_STATE(benchmark_kernel_number_schedules) = 1;
+    benchmark_track_reset_sched_utilisation();
     benchmark_arch_utilisation_reset();
 #endif /* CONFIG_BENCHMARK_TRACK_UTILISATION */
 
@@ -61,6 +89,37 @@ exception_t handle_SysBenchmarkResetLog(void)
 exception_t handle_SysBenchmarkFinalizeLog(void)
 {
 #ifdef CONFIG_KERNEL_LOG_BUFFER
+#if defined(CONFIG_BENCHMARK_TRACK_KERNEL_ENTRIES_RING) || \
+    defined(CONFIG_BENCHMARK_TRACK_KERNEL_ENTRIES_HISTOGRAM) || \
+    defined(CONFIG_BENCHMARK_SAMPLE_PROFILE) || \
+    defined(CONFIG_BENCHMARK_IRQ_LATENCY) || \
+    defined(CONFIG_BENCHMARK_SCHED_TRACE)
+    /* These modes count their records in the log buffer */
+    if (ksUserLogBuffer == 0) {
+        userError("A user-level buffer has to be set before finalizing benchmark.\
+                Use seL4_BenchmarkSetLogBuffer\n");
+        setRegister(NODE_STATE(ksCurThread), capRegister, seL4_IllegalOperation);
+        return EXCEPTION_SYSCALL_ERROR;
+    }
+#endif
+
+#ifdef CONFIG_BENCHMARK_TRACK_KERNEL_ENTRIES_RING
+    ksLogIndex = benchmark_track_ring_count();
+#endif
+#ifdef CONFIG_BENCHMARK_TRACK_KERNEL_ENTRIES_HISTOGRAM
+    ksLogIndex = benchmark_track_histogram_count();
+#endif
+#ifdef CONFIG_BENCHMARK_IRQ_LATENCY
+    ksLogIndex = benchmark_irq_latency_count();
+#endif
+#ifdef CONFIG_BENCHMARK_SAMPLE_PROFILE
+    ksSampleProfileEnabled = false;
+    ksLogIndex = benchmark_sample_count();
+#endif
+#ifdef CONFIG_BENCHMARK_SCHED_TRACE
+    ksSchedTraceEnabled = false;
+    ksLogIndex = benchmark_sched_count();
+#endif
     ksLogIndexFinalized = ksLogIndex;
     setRegister(NODE_STATE(ksCurThread), capRegister, ksLogIndexFinalized);
 #endif /* CONFIG_KERNEL_LOG_BUFFER */
@@ -81,6 +140,22 @@ exception_t handle_SysBenchmarkSetLogBuffer(void)
         return EXCEPTION_SYSCALL_ERROR;
     }
 
+#ifdef CONFIG_BENCHMARK_TRACK_KERNEL_ENTRIES_RING
+    benchmark_track_ring_reset();
+#endif
+#ifdef CONFIG_BENCHMARK_TRACK_KERNEL_ENTRIES_HISTOGRAM
+    benchmark_track_histogram_reset();
+#endif
+#ifdef CONFIG_BENCHMARK_IRQ_LATENCY
+    benchmark_irq_latency_reset();
+#endif
+#ifdef CONFIG_BENCHMARK_SAMPLE_PROFILE
+    benchmark_sample_reset();
+#endif
+#ifdef CONFIG_BENCHMARK_SCHED_TRACE
+    benchmark_sched_reset();
+#endif
+
     setRegister(NODE_STATE(ksCurThread), capRegister, seL4_NoError);
     return EXCEPTION_NONE;
 }
@@ -114,6 +189,65 @@ exception_t handle_SysBenchmarkResetThreadUtilisation(void)
     return EXCEPTION_NONE;
 }
 
+compile_assert(domain_utilisation_fits_ipc_buffer,
+               CONFIG_MAX_NUM_NODES * BENCHMARK_DOMAIN_NUM_COUNTERS * sizeof(uint64_t) <=
+               seL4_MsgMaxLength * sizeof(seL4_Word))
+
+exception_t handle_SysBenchmarkGetDomainUtilisation(void)
+{
+    word_t domain = getRegister(NODE_STATE(ksCurThread), capRegister);
+    word_t *ipcBuffer = lookupIPCBuffer(true, NODE_STATE(ksCurThread));
+
+    if (domain >= CONFIG_NUM_DOMAINS || ipcBuffer == NULL) {
+        userError("SysBenchmarkGetDomainUtilisation: invalid domain or no IPC buffer");
+        setRegister(NODE_STATE(ksCurThread), capRegister, seL4_InvalidArgument);
+        return EXCEPTION_NONE;
+    }
+
+    uint64_t *buffer = (uint64_t *) & (((seL4_IPCBuffer *)ipcBuffer)->msg[0]);
+    for (word_t core = 0; core < CONFIG_MAX_NUM_NODES; core++) {
+        for (word_t counter = 0; counter < BENCHMARK_DOMAIN_NUM_COUNTERS; counter++) {
+            buffer[core * BENCHMARK_DOMAIN_NUM_COUNTERS + counter] =
+                NODE_STATE_ON_CORE(benchmark_domain_utilisation, core)[domain][counter];
+        }
+    }
+    setRegister(NODE_STATE(ksCurThread), capRegister, seL4_NoError);
+    return EXCEPTION_NONE;
+}
+
+#ifdef CONFIG_KERNEL_MCS
+exception_t handle_SysBenchmarkGetSchedContextUtilisation(void)
+{
+    word_t sc_cptr = getRegister(NODE_STATE(ksCurThread), capRegister);
+    word_t *ipcBuffer = lookupIPCBuffer(true, NODE_STATE(ksCurThread));
+    lookupCap_ret_t lu_ret;
+
+    lu_ret = lookupCap(NODE_STATE(ksCurThread), sc_cptr);
+    if (cap_get_capType(lu_ret.cap) != cap_sched_context_cap || ipcBuffer == NULL) {
+        userError("SysBenchmarkGetSchedContextUtilisation: cap is not a scheduling context or no IPC buffer");
+        setRegister(NODE_STATE(ksCurThread), capRegister, seL4_InvalidCapability);
+        return EXCEPTION_NONE;
+    }
+
+    sched_context_t *sc = SC_PTR(cap_sched_context_cap_get_capSCPtr(lu_ret.cap));
+    uint64_t *buffer = (uint64_t *) & (((seL4_IPCBuffer *)ipcBuffer)->msg[0]);
+    for (word_t counter = 0; counter <= BENCHMARK_SC_TABLE_OVERFLOW; counter++) {
+        buffer[counter] = 0;
+    }
+    for (word_t core = 0; core < CONFIG_MAX_NUM_NODES; core++) {
+        uint64_t *counters = benchmark_sc_utilisation_find(core, sc);
+        if (counters != NULL) {
+            for (word_t counter = 0; counter < BENCHMARK_SC_NUM_COUNTERS; counter++) {
+                buffer[counter] += counters[counter];
+            }
+        }
+        buffer[BENCHMARK_SC_TABLE_OVERFLOW] += NODE_STATE_ON_CORE(benchmark_sc_utilisation_overflow, core);
+    }
+    setRegister(NODE_STATE(ksCurThread), capRegister, seL4_NoError);
+    return EXCEPTION_NONE;
+}
+#endif /* CONFIG_KERNEL_MCS */
+
 #ifdef CONFIG_DEBUG_BUILD
 
 exception_t handle_SysBenchmarkDumpAllThreadsUtilisation(void)
@@ -153,4 +287,70 @@ exception_t handle_SysBenchmarkResetAllThreadsUtilisation(void)
 
 #endif /* CONFIG_DEBUG_BUILD */
 #endif /* CONFIG_BENCHMARK_TRACK_UTILISATION */
+
+#ifdef CONFIG_BENCHMARK_FASTPATH_COUNTERS
+compile_assert(fastpath_counters_fit_ipc_buffer,
+               BENCHMARK_FASTPATH_IPC_COUNTERS * sizeof(uint64_t) <= seL4_MsgMaxLength * sizeof(seL4_Word))
+
+exception_t handle_SysBenchmarkGetFastpathCounters(void)
+{
+    word_t core = getRegister(NODE_STATE(ksCurThread), capRegister);
+    word_t *ipcBuffer = lookupIPCBuffer(true, NODE_STATE(ksCurThread));
+
+    if (core >= CONFIG_MAX_NUM_NODES || ipcBuffer == NULL) {
+        userError("SysBenchmarkGetFastpathCounters: invalid core or no IPC buffer");
+        setRegister(NODE_STATE(ksCurThread), capRegister, seL4_InvalidArgument);
+        return EXCEPTION_NONE;
+    }
+
+    uint64_t *buffer = (uint64_t *) & (((seL4_IPCBuffer *)ipcBuffer)->msg[0]);
+    for (word_t path = 0; path < BENCHMARK_FASTPATH_NUM_PATHS; path++) {
+        for (word_t counter = 0; counter < BENCHMARK_FASTPATH_NUM_COUNTERS; counter++) {
+            buffer[path * BENCHMARK_FASTPATH_NUM_COUNTERS + counter] =
+                NODE_STATE_ON_CORE(ksFastpathCounters, core)[path][counter];
+        }
+    }
+    setRegister(NODE_STATE(ksCurThread), capRegister, seL4_NoError);
+    return EXCEPTION_NONE;
+}
+
+exception_t handle_SysBenchmarkResetFastpathCounters(void)
+{
+    benchmark_fastpath_reset();
+    return EXCEPTION_NONE;
+}
+#endif /* CONFIG_BENCHMARK_FASTPATH_COUNTERS */
+
+#ifdef CONFIG_BENCHMARK_PREEMPTION_LATENCY
+compile_assert(preemption_counters_fit_ipc_buffer,
+               BENCHMARK_PREEMPTION_IPC_COUNTERS * sizeof(uint64_t) <= seL4_MsgMaxLength * sizeof(seL4_Word))
+
+exception_t handle_SysBenchmarkGetPreemptionCounters(void)
+{
+    word_t core = getRegister(NODE_STATE(ksCurThread), capRegister);
+    word_t *ipcBuffer = lookupIPCBuffer(true, NODE_STATE(ksCurThread));
+
+    if (core >= CONFIG_MAX_NUM_NODES || ipcBuffer == NULL) {
+        userError("SysBenchmarkGetPreemptionCounters: invalid core or no IPC buffer");
+        setRegister(NODE_STATE(ksCurThread), capRegister, seL4_InvalidArgument);
+        return EXCEPTION_NONE;
+    }
+
+    uint64_t *buffer = (uint64_t *) & (((seL4_IPCBuffer *)ipcBuffer)->msg[0]);
+    for (word_t op = 0; op < BENCHMARK_PREEMPTION_NUM_OPS; op++) {
+        for (word_t counter = 0; counter < BENCHMARK_PREEMPTION_NUM_COUNTERS; counter++) {
+            buffer[op * BENCHMARK_PREEMPTION_NUM_COUNTERS + counter] =
+                NODE_STATE_ON_CORE(ksPreemptionCounters, core)[op][counter];
+        }
+    }
+    setRegister(NODE_STATE(ksCurThread), capRegister, seL4_NoError);
+    return EXCEPTION_NONE;
+}
+
+exception_t handle_SysBenchmarkResetPreemptionCounters(void)
+{
+    benchmark_preemption_reset();
+    return EXCEPTION_NONE;
+}
+#endif /* CONFIG_BENCHMARK_PREEMPTION_LATENCY */
 #endif /* CONFIG_ENABLE_BENCHMARKS */
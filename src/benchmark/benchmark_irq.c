@@ -0,0 +1,141 @@
+/*
+ * Copyright 2026, seL4 Project a Series of LF Projects, LLC
+ *
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#include <config.h>
+
+#ifdef CONFIG_BENCHMARK_IRQ_LATENCY
+
+#include <benchmark/benchmark_irq.h>
+#include <benchmark/benchmark_histogram.h>
+#include <model/statedata.h>
+#include <machine.h>
+
+void benchmark_irq_latency_reset(void)
+{
+    memzero((void *)KS_LOG_PPTR, seL4_LogIRQLatencyTableSize * CONFIG_MAX_NUM_NODES);
+}
+
+word_t benchmark_irq_latency_count(void)
+{
+    word_t count = 0;
+
+    for (word_t i = 0; i < CONFIG_MAX_NUM_NODES; i++) {
+        count += benchmark_irq_latency_table(i)->used;
+    }
+    return count;
+}
+
+static inline void benchmark_irq_latency_stamp(benchmark_irq_latency_pending_t *pending, word_t stage)
+{
+    pending->latency[stage] = timestamp() - pending->enter;
+    pending->reached |= BIT(stage);
+}
+
+static void benchmark_irq_latency_commit(benchmark_irq_latency_pending_t *pending)
+{
+    benchmark_irq_latency_table_t *table;
+    benchmark_irq_latency_t *record;
+    benchmark_irq_latency_stage_t *stage;
+    word_t tcb = pending->tcb;
+    word_t i, index;
+
+    pending->active = false;
+    if (unlikely(ksUserLogBuffer == 0)) {
+        return;
+    }
+
+    /* Open addressing with linear probing, as for the kernel entry histograms */
+    table = benchmark_irq_latency_table(CURRENT_CPU_INDEX());
+    index = ((pending->irq ^ (tcb >> seL4_TCBBits)) * 0x9e3779b1u) % seL4_LogIRQLatencies;
+    for (i = 0; i < seL4_LogIRQLatencies; i++) {
+        record = &table->records[index];
+        if (record->stages[BENCHMARK_IRQ_LATENCY_DISPATCH].count == 0) {
+            record->irq = pending->irq;
+            record->tcb = tcb;
+            table->used++;
+            break;
+        }
+        if (record->irq == pending->irq && record->tcb == tcb) {
+            break;
+        }
+        index = (index + 1 == seL4_LogIRQLatencies) ? 0 : index + 1;
+    }
+    if (unlikely(i == seL4_LogIRQLatencies)) {
+        table->overflow++;
+        return;
+    }
+
+    for (i = 0; i < BENCHMARK_IRQ_LATENCY_NUM_STAGES; i++) {
+        if (pending->reached & BIT(i)) {
+            uint32_t latency = pending->latency[i];
+
+            stage = &record->stages[i];
+            if (stage->count == 0 || latency < stage->min) {
+                stage->min = latency;
+            }
+            if (latency > stage->max) {
+                stage->max = latency;
+            }
+            stage->count++;
+            stage->total += latency;
+            stage->buckets[benchmark_histogram_bucket(latency)]++;
+        }
+    }
+}
+
+void benchmark_irq_latency_dispatch(word_t irq)
+{
+    benchmark_irq_latency_pending_t *pending = &NODE_STATE(ksIRQLatency);
+
+    if (pending->active) {
+        benchmark_irq_latency_commit(pending);
+    }
+    pending->enter = pending->kernel_enter;
+    pending->reached = 0;
+    pending->irq = irq;
+    pending->tcb = 0;
+    pending->remote = false;
+    pending->active = true;
+    benchmark_irq_latency_stamp(pending, BENCHMARK_IRQ_LATENCY_DISPATCH);
+}
+
+void benchmark_irq_latency_signal(void)
+{
+    benchmark_irq_latency_stamp(&NODE_STATE(ksIRQLatency), BENCHMARK_IRQ_LATENCY_SIGNAL);
+}
+
+void benchmark_irq_latency_wake(tcb_t *tcb)
+{
+    benchmark_irq_latency_pending_t *pending = &NODE_STATE(ksIRQLatency);
+
+    /* sendSignal is also reached from seL4_Signal, which must not be taken
+     * for the IRQ's signal */
+    if (pending->active && pending->reached == BIT(BENCHMARK_IRQ_LATENCY_DISPATCH)) {
+        pending->tcb = (word_t)tcb;
+#ifdef ENABLE_SMP_SUPPORT
+        pending->remote = tcb->tcbAffinity != getCurrentCPUIndex();
+#endif
+    }
+}
+
+void benchmark_irq_latency_exit(void)
+{
+    benchmark_irq_latency_pending_t *pending = &NODE_STATE(ksIRQLatency);
+
+    if (likely(!pending->active)) {
+        return;
+    }
+    /* The woken thread is only compared against, as it may have been deleted
+     * by the time it would run */
+    if (pending->tcb == (word_t)NODE_STATE(ksCurThread) && !pending->remote) {
+        benchmark_irq_latency_stamp(pending, BENCHMARK_IRQ_LATENCY_USER);
+        benchmark_irq_latency_commit(pending);
+    } else if (pending->tcb == 0 || pending->remote) {
+        benchmark_irq_latency_commit(pending);
+    }
+}
+
+#endif /* CONFIG_BENCHMARK_IRQ_LATENCY */
@@ -0,0 +1,73 @@
+/*
+ * Copyright 2026, seL4 Project a Series of LF Projects, LLC
+ *
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#include <config.h>
+
+#ifdef CONFIG_BENCHMARK_SAMPLE_PROFILE
+
+#include <benchmark/benchmark_sample.h>
+#include <model/statedata.h>
+#include <machine.h>
+
+bool_t ksSampleProfileEnabled;
+
+void benchmark_sample_reset(void)
+{
+    for (word_t i = 0; i < CONFIG_MAX_NUM_NODES; i++) {
+        benchmark_sample_log_t *log = benchmark_sample_log(i);
+        log->count = 0;
+        log->dropped = 0;
+        NODE_STATE_ON_CORE(ksLogSampleCount, i) = 0;
+    }
+}
+
+word_t benchmark_sample_count(void)
+{
+    word_t count = 0;
+
+    for (word_t i = 0; i < CONFIG_MAX_NUM_NODES; i++) {
+        count += NODE_STATE_ON_CORE(ksLogSampleCount, i);
+    }
+    return count;
+}
+
+void benchmark_sample_record(void)
+{
+    tcb_t *thread = NODE_STATE(ksCurThread);
+    benchmark_sample_log_t *log;
+    benchmark_sample_t *sample;
+    word_t count;
+
+    if (likely(ksSampleProfileEnabled && ksUserLogBuffer != 0)) {
+        /* The log is writable from user level, so the samples are placed
+         * using the kernel's own count and it is only published to the log */
+        log = benchmark_sample_log(CURRENT_CPU_INDEX());
+        count = NODE_STATE(ksLogSampleCount);
+        if (unlikely(count >= seL4_LogSamples)) {
+            log->dropped++;
+            return;
+        }
+
+        sample = &log->samples[count];
+        sample->time = timestamp();
+        sample->tcb = (word_t)thread;
+        sample->pc = getRestartPC(thread);
+        sample->core = CURRENT_CPU_INDEX();
+        sample->kernel = thread == NODE_STATE(ksIdleThread);
+#if CONFIG_BENCHMARK_SAMPLE_PROFILE_USER_FRAMES > 0
+        for (word_t i = 0; i < CONFIG_BENCHMARK_SAMPLE_PROFILE_USER_FRAMES; i++) {
+            sample->frames[i] = 0;
+        }
+        if (!sample->kernel) {
+            benchmark_arch_sample_user_frames(thread, sample->frames);
+        }
+#endif
+        NODE_STATE(ksLogSampleCount) = count + 1;
+        log->count = count + 1;
+    }
+}
+
+#endif /* CONFIG_BENCHMARK_SAMPLE_PROFILE */
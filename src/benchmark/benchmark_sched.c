@@ -0,0 +1,99 @@
+/*
+ * Copyright 2026, seL4 Project a Series of LF Projects, LLC
+ *
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#include <config.h>
+
+#ifdef CONFIG_BENCHMARK_SCHED_TRACE
+
+#include <benchmark/benchmark_sched.h>
+#include <kernel/thread.h>
+#include <model/statedata.h>
+#include <machine.h>
+
+bool_t ksSchedTraceEnabled;
+
+void benchmark_sched_reset(void)
+{
+    for (word_t i = 0; i < CONFIG_MAX_NUM_NODES; i++) {
+        benchmark_sched_log_t *log = benchmark_sched_log(i);
+        log->count = 0;
+        log->dropped = 0;
+        NODE_STATE_ON_CORE(ksLogSchedCount, i) = 0;
+    }
+}
+
+word_t benchmark_sched_count(void)
+{
+    word_t count = 0;
+
+    for (word_t i = 0; i < CONFIG_MAX_NUM_NODES; i++) {
+        count += NODE_STATE_ON_CORE(ksLogSchedCount, i);
+    }
+    return count;
+}
+
+void benchmark_sched_record(word_t type, tcb_t *tcb, uint64_t arg)
+{
+    benchmark_sched_log_t *log;
+    benchmark_sched_event_t *event;
+    word_t count;
+
+    if (likely(ksSchedTraceEnabled && ksUserLogBuffer != 0)) {
+        /* As for the sample profiler, events are placed using the kernel's
+         * own count, which is only published to the log */
+        log = benchmark_sched_log(CURRENT_CPU_INDEX());
+        count = NODE_STATE(ksLogSchedCount);
+        if (unlikely(count >= seL4_LogSchedEvents)) {
+            log->dropped++;
+            return;
+        }
+
+        event = &log->events[count];
+        event->time = timestamp();
+        event->tcb = (word_t)tcb;
+        event->arg = arg;
+        event->type = type;
+        event->core = CURRENT_CPU_INDEX();
+        NODE_STATE(ksLogSchedCount) = count + 1;
+        log->count = count + 1;
+    }
+}
+
+/* Same as isRunnable, for a state the thread is not in yet */
+static bool_t benchmark_sched_runnable(word_t ts)
+{
+    switch (ts) {
+    case ThreadState_Running:
+    case ThreadState_Restart:
+#ifdef CONFIG_VTX
+    case ThreadState_RunningVM:
+#endif
+        return true;
+
+    default:
+        return false;
+    }
+}
+
+void benchmark_sched_state(tcb_t *tcb, word_t ts)
+{
+    bool_t runnable = benchmark_sched_runnable(ts);
+
+    if (runnable != isRunnable(tcb)) {
+        benchmark_sched_record(runnable ? BENCHMARK_SCHED_WAKE : BENCHMARK_SCHED_BLOCK, tcb, ts);
+    }
+}
+
+void benchmark_sched_fastpath_switch(tcb_t *thread)
+{
+    tcb_t *cur = NODE_STATE(ksCurThread);
+
+    benchmark_sched_record(BENCHMARK_SCHED_BLOCK, cur, thread_state_get_tsType(cur->tcbState));
+    benchmark_sched_record(BENCHMARK_SCHED_WAKE, thread, ThreadState_Running);
+    benchmark_sched_record(BENCHMARK_SCHED_SWITCH, thread, thread->tcbPriority);
+}
+
+#endif /* CONFIG_BENCHMARK_SCHED_TRACE */
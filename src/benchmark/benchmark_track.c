@@ -6,14 +6,137 @@
 
 #include <config.h>
 #include <benchmark/benchmark_track.h>
+#include <benchmark/benchmark_histogram.h>
 #include <model/statedata.h>
 
 #ifdef CONFIG_BENCHMARK_TRACK_KERNEL_ENTRIES
 
 timestamp_t ksEnter;
-seL4_Word ksLogIndex;
-seL4_Word ksLogIndexFinalized;
 
+#ifdef CONFIG_BENCHMARK_TRACK_KERNEL_ENTRIES_RING
+void benchmark_track_ring_reset(void)
+{
+    for (word_t i = 0; i < CONFIG_MAX_NUM_NODES; i++) {
+        benchmark_track_ring_t *ring = benchmark_track_ring(i);
+        ring->head = 0;
+        ring->dropped = 0;
+        ring->tail = 0;
+        NODE_STATE_ON_CORE(ksLogRingSlot, i) = 0;
+    }
+}
+
+word_t benchmark_track_ring_count(void)
+{
+    word_t count = 0;
+
+    for (word_t i = 0; i < CONFIG_MAX_NUM_NODES; i++) {
+        count += benchmark_track_ring(i)->head;
+    }
+    return count;
+}
+
+void benchmark_track_exit(void)
+{
+    timestamp_t ksExit = timestamp();
+    benchmark_track_ring_t *ring;
+    benchmark_track_kernel_entry_t *log_entry;
+    word_t head, slot;
+
+    if (likely(ksUserLogBuffer != 0)) {
+        ring = benchmark_track_ring(CURRENT_CPU_INDEX());
+        head = ring->head;
+
+        /* The consumer controls tail, which only decides whether the ring is
+         * full. Entries are placed using the kernel's own slot index. */
+        if (unlikely(head - __atomic_load_n(&ring->tail, __ATOMIC_ACQUIRE) >= seL4_LogRingEntries)) {
+            ring->dropped++;
+            return;
+        }
+
+        slot = NODE_STATE(ksLogRingSlot);
+        log_entry = &ring->entries[slot];
+        log_entry->entry = ksKernelEntry;
+        log_entry->start_time = ksEnter;
+        log_entry->duration = ksExit - ksEnter;
+        NODE_STATE(ksLogRingSlot) = (slot + 1 == seL4_LogRingEntries) ? 0 : slot + 1;
+
+        /* Publish the entry only once it is completely written */
+        __atomic_store_n(&ring->head, head + 1, __ATOMIC_RELEASE);
+    }
+}
+#elif defined(CONFIG_BENCHMARK_TRACK_KERNEL_ENTRIES_HISTOGRAM)
+void benchmark_track_histogram_reset(void)
+{
+    memzero((void *)KS_LOG_PPTR, seL4_LogHistogramTableSize * CONFIG_MAX_NUM_NODES);
+}
+
+word_t benchmark_track_histogram_count(void)
+{
+    word_t count = 0;
+
+    for (word_t i = 0; i < CONFIG_MAX_NUM_NODES; i++) {
+        count += benchmark_track_histogram_table(i)->used;
+    }
+    return count;
+}
+
+static inline bool_t benchmark_histogram_key_equals(kernel_entry_t a, kernel_entry_t b)
+{
+    return a.path == b.path && a.syscall_no == b.syscall_no && a.cap_type == b.cap_type &&
+           a.invocation_tag == b.invocation_tag;
+}
+
+void benchmark_track_exit(void)
+{
+    timestamp_t ksExit = timestamp();
+    benchmark_track_histogram_table_t *table;
+    benchmark_track_histogram_t *hist;
+    kernel_entry_t key = { 0 };
+    uint32_t duration;
+    word_t i, index;
+
+    if (likely(ksUserLogBuffer != 0)) {
+        key.path = ksKernelEntry.path;
+        if (ksKernelEntry.path == Entry_Syscall) {
+            key.syscall_no = ksKernelEntry.syscall_no;
+            key.cap_type = ksKernelEntry.cap_type;
+            key.invocation_tag = ksKernelEntry.invocation_tag;
+        }
+
+        /* Open addressing with linear probing. Unused histograms are never
+         * handed back before the next reset, so the first unused one ends the
+         * search. */
+        table = benchmark_track_histogram_table(CURRENT_CPU_INDEX());
+        index = ((key.path ^ (key.syscall_no << 3) ^ (key.cap_type << 7) ^
+                  ((word_t)key.invocation_tag << 12)) * 0x9e3779b1u) % seL4_LogHistograms;
+        for (i = 0; i < seL4_LogHistograms; i++) {
+            hist = &table->histograms[index];
+            if (hist->count == 0) {
+                hist->key = key;
+                table->used++;
+                break;
+            }
+            if (benchmark_histogram_key_equals(hist->key, key)) {
+                break;
+            }
+            index = (index + 1 == seL4_LogHistograms) ? 0 : index + 1;
+        }
+        if (unlikely(i == seL4_LogHistograms)) {
+            table->overflow++;
+            return;
+        }
+
+        duration = ksExit - ksEnter;
+        if (hist->count == 0 || duration > hist->max_duration) {
+            hist->max_duration = duration;
+            hist->max_start_time = ksEnter;
+        }
+        hist->count++;
+        hist->total_duration += duration;
+        hist->buckets[benchmark_histogram_bucket(duration)]++;
+    }
+}
+#else
 void benchmark_track_exit(void)
 {
     timestamp_t duration = 0;
@@ -31,4 +154,5 @@ void benchmark_track_exit(void)
         }
     }
 }
+#endif /* CONFIG_BENCHMARK_TRACK_KERNEL_ENTRIES_RING */
 #endif /* CONFIG_BENCHMARK_TRACK_KERNEL_ENTRIES */
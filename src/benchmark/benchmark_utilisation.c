@@ -11,6 +11,13 @@
 
 timestamp_t ksEnter;
 
+#ifdef CONFIG_BENCHMARK_TRACK_UTILISATION_PMU
+/* The counts are returned as 64-bit values in the IPC buffer */
+compile_assert(benchmark_pmu_counters_fit_ipc_buffer,
+               (BENCHMARK_TCB_PMU_COUNTERS + 2 * BENCHMARK_PMU_NUM_EVENTS) * sizeof(uint64_t) <=
+               seL4_MsgMaxLength * sizeof(seL4_Word))
+#endif
+
 void benchmark_track_utilisation_dump(void)
 {
     uint64_t *buffer = ((uint64_t *) & (((seL4_IPCBuffer *)lookupIPCBuffer(true, NODE_STATE(ksCurThread)))->msg[0]));
@@ -65,6 +72,14 @@ void benchmark_track_utilisation_dump(void)
     buffer[BENCHMARK_TOTAL_KERNEL_UTILISATION] = NODE_STATE(benchmark_kernel_time);
     buffer[BENCHMARK_TOTAL_NUMBER_KERNEL_ENTRIES] = NODE_STATE(benchmark_kernel_number_entries);
 
+#ifdef CONFIG_BENCHMARK_TRACK_UTILISATION_PMU
+    /* Selected TCB PMU event counts */
+    for (word_t i = 0; i < BENCHMARK_PMU_NUM_EVENTS; i++) {
+        buffer[BENCHMARK_TCB_PMU_COUNTERS + i] = TCB_PTR_PMU_PTR(tcb)->pmu_user[i];
+        buffer[BENCHMARK_TCB_PMU_COUNTERS + BENCHMARK_PMU_NUM_EVENTS + i] = TCB_PTR_PMU_PTR(tcb)->pmu_kernel[i];
+    }
+#endif /* CONFIG_BENCHMARK_TRACK_UTILISATION_PMU */
+
 }
 
 void benchmark_track_reset_utilisation(tcb_t *tcb)
@@ -74,5 +89,152 @@ void benchmark_track_reset_utilisation(tcb_t *tcb)
     tcb->benchmark.number_kernel_entries = 0;
     tcb->benchmark.kernel_utilisation = 0;
     tcb->benchmark.schedule_start_time = 0;
+#ifdef CONFIG_BENCHMARK_TRACK_UTILISATION_PMU
+    for (word_t i = 0; i < BENCHMARK_PMU_NUM_EVENTS; i++) {
+        TCB_PTR_PMU_PTR(tcb)->pmu_user[i] = 0;
+        TCB_PTR_PMU_PTR(tcb)->pmu_kernel[i] = 0;
+    }
+#endif /* CONFIG_BENCHMARK_TRACK_UTILISATION_PMU */
+}
+
+void benchmark_track_reset_sched_utilisation(void)
+{
+    memzero(NODE_STATE(benchmark_domain_utilisation), sizeof(NODE_STATE(benchmark_domain_utilisation)));
+#ifdef CONFIG_KERNEL_MCS
+    memzero(NODE_STATE(benchmark_sc_utilisation), sizeof(NODE_STATE(benchmark_sc_utilisation)));
+    NODE_STATE(benchmark_sc_utilisation_overflow) = 0;
+#endif
+}
+
+#ifdef CONFIG_KERNEL_MCS
+static inline word_t benchmark_sc_utilisation_hash(sched_context_t *sc)
+{
+    return (((word_t)sc >> seL4_MinSchedContextBits) * 0x9e3779b1u) % CONFIG_BENCHMARK_TRACK_UTILISATION_SCHED_CONTEXTS;
+}
+
+uint64_t *benchmark_sc_utilisation_find(word_t core, sched_context_t *sc)
+{
+    benchmark_sc_util_t *table = NODE_STATE_ON_CORE(benchmark_sc_utilisation, core);
+    word_t index = benchmark_sc_utilisation_hash(sc);
+
+    for (word_t i = 0; i < CONFIG_BENCHMARK_TRACK_UTILISATION_SCHED_CONTEXTS; i++) {
+        if (table[index].sc == sc) {
+            return table[index].counters;
+        }
+        if (table[index].sc == NULL) {
+            return NULL;
+        }
+        index = (index + 1 == CONFIG_BENCHMARK_TRACK_UTILISATION_SCHED_CONTEXTS) ? 0 : index + 1;
+    }
+    return NULL;
+}
+
+/* Find or add the counters of sc on the current core. Open addressing with
+ * linear probing, see benchmark_sc_utilisation_remove for deleting entries. */
+static uint64_t *benchmark_sc_utilisation_get(sched_context_t *sc)
+{
+    benchmark_sc_util_t *table = NODE_STATE(benchmark_sc_utilisation);
+    word_t index = benchmark_sc_utilisation_hash(sc);
+
+    for (word_t i = 0; i < CONFIG_BENCHMARK_TRACK_UTILISATION_SCHED_CONTEXTS; i++) {
+        if (table[index].sc == sc) {
+            return table[index].counters;
+        }
+        if (table[index].sc == NULL) {
+            table[index].sc = sc;
+            return table[index].counters;
+        }
+        index = (index + 1 == CONFIG_BENCHMARK_TRACK_UTILISATION_SCHED_CONTEXTS) ? 0 : index + 1;
+    }
+    NODE_STATE(benchmark_sc_utilisation_overflow)++;
+    return NULL;
+}
+
+void benchmark_sc_utilisation_remove(sched_context_t *sc)
+{
+    const word_t size = CONFIG_BENCHMARK_TRACK_UTILISATION_SCHED_CONTEXTS;
+
+    for (word_t core = 0; core < CONFIG_MAX_NUM_NODES; core++) {
+        benchmark_sc_util_t *table = NODE_STATE_ON_CORE(benchmark_sc_utilisation, core);
+        word_t hole = benchmark_sc_utilisation_hash(sc);
+        word_t next;
+
+        for (word_t i = 0; i < size && table[hole].sc != NULL && table[hole].sc != sc; i++) {
+            hole = (hole + 1) % size;
+        }
+        if (table[hole].sc != sc) {
+            continue;
+        }
+
+        /* Move later entries of the probe sequence back into the hole, unless
+         * that would place them before the slot they hash to */
+        table[hole].sc = NULL;
+        for (next = (hole + 1) % size; table[next].sc != NULL; next = (next + 1) % size) {
+            word_t home = benchmark_sc_utilisation_hash(table[next].sc);
+            if ((next + size - home) % size >= (next + size - hole) % size) {
+                table[hole] = table[next];
+                table[next].sc = NULL;
+                hole = next;
+            }
+        }
+        memzero(table[hole].counters, sizeof(table[hole].counters));
+    }
+}
+
+void benchmark_utilisation_consumed(ticks_t consumed)
+{
+    uint64_t *sc;
+
+    if (likely(NODE_STATE(benchmark_log_utilisation_enabled))) {
+        sc = benchmark_sc_utilisation_get(NODE_STATE(ksCurSC));
+        if (sc != NULL) {
+            sc[BENCHMARK_SC_CONSUMED] += consumed;
+        }
+    }
+}
+#endif /* CONFIG_KERNEL_MCS */
+
+static void benchmark_utilisation_sched_account(timestamp_t time, bool_t kernel)
+{
+    uint64_t *domain = NODE_STATE(benchmark_domain_utilisation)[ksCurDomain];
+
+    if (NODE_STATE(ksCurThread) == NODE_STATE(ksIdleThread)) {
+        domain[BENCHMARK_DOMAIN_IDLE_UTILISATION] += time;
+    } else {
+        domain[BENCHMARK_DOMAIN_UTILISATION] += time;
+    }
+    if (kernel) {
+        domain[BENCHMARK_DOMAIN_KERNEL_UTILISATION] += time;
+        domain[BENCHMARK_DOMAIN_NUMBER_KERNEL_ENTRIES]++;
+    }
+
+#ifdef CONFIG_KERNEL_MCS
+    uint64_t *sc = benchmark_sc_utilisation_get(NODE_STATE(ksCurSC));
+    if (sc != NULL) {
+        sc[BENCHMARK_SC_UTILISATION] += time;
+        /* A scheduling context passed over a call has the reply object of the
+         * caller on its call stack */
+        if (NODE_STATE(ksCurSC)->scReply != NULL) {
+            sc[BENCHMARK_SC_DONATED_UTILISATION] += time;
+        }
+        if (kernel) {
+            sc[BENCHMARK_SC_KERNEL_UTILISATION] += time;
+            sc[BENCHMARK_SC_NUMBER_KERNEL_ENTRIES]++;
+        }
+    }
+#endif
+}
+
+void benchmark_utilisation_sched_enter(void)
+{
+    if (likely(NODE_STATE(benchmark_log_utilisation_enabled))) {
+        benchmark_utilisation_sched_account(ksEnter - NODE_STATE(benchmark_exit_time), false);
+    }
+}
+
+void benchmark_utilisation_sched_exit(timestamp_t exit)
+{
+    benchmark_utilisation_sched_account(exit - ksEnter, true);
+    NODE_STATE(benchmark_exit_time) = exit;
 }
 #endif /* CONFIG_BENCHMARK_TRACK_UTILISATION */
@@ -36,6 +36,9 @@ add_sources(
         src/machine/fpu.c
         src/benchmark/benchmark.c
         src/benchmark/benchmark_track.c
+        src/benchmark/benchmark_irq.c
+        src/benchmark/benchmark_sample.c
+        src/benchmark/benchmark_sched.c
         src/benchmark/benchmark_utilisation.c
         src/smp/lock.c
         src/smp/ipi.c
@@ -55,6 +55,12 @@ struct smmu_table_config {
 
 static struct smmu_feature smmu_dev_knowledge;
 static struct smmu_table_config smmu_stage_table_config;
+#ifdef CONFIG_ARM_SMMU_DEFER_TLB_SYNC
+/*TLB maintenance issued but not yet synchronised, global and per context bank*/
+static bool_t smmu_sync_pending;
+static bool_t smmu_global_sync_pending;
+static bool_t smmu_cb_sync_pending[SMMU_MAX_CB];
+#endif
 
 
 static inline uint32_t smmu_read_reg32(pptr_t base, uint32_t index)
@@ -90,6 +96,26 @@ static void smmu_tlb_sync(pptr_t base, uint32_t sync, uint32_t status)
     }
 }
 
+static inline void smmu_global_tlb_sync(void)
+{
+#ifdef CONFIG_ARM_SMMU_DEFER_TLB_SYNC
+    smmu_global_sync_pending = true;
+    smmu_sync_pending = true;
+#else
+    smmu_tlb_sync(SMMU_GR0_PPTR, SMMU_sTLBGSYNC, SMMU_sTLBGSTATUS);
+#endif
+}
+
+static inline void smmu_cb_tlb_sync(int cb)
+{
+#ifdef CONFIG_ARM_SMMU_DEFER_TLB_SYNC
+    smmu_cb_sync_pending[cb] = true;
+    smmu_sync_pending = true;
+#else
+    smmu_tlb_sync(SMMU_CBn_BASE_PPTR(cb), SMMU_CBn_TLBSYNC, SMMU_CBn_TLBSTATUS);
+#endif
+}
+
 static inline uint32_t smmu_obs_size_to_bits(uint32_t size)
 {
     /*coverting the output bus address size into address bit, defined in
@@ -581,7 +607,7 @@ void smmu_tlb_invalidate_all(void)
     smmu_write_reg32(SMMU_GR0_PPTR, SMMU_TLBIALLNSNH, SMMU_TLB_INVALL_MASK);
 #endif
     /*syn above TLB operations*/
-    smmu_tlb_sync(SMMU_GR0_PPTR, SMMU_sTLBGSYNC, SMMU_sTLBGSTATUS);
+    smmu_global_tlb_sync();
 }
 
 void smmu_tlb_invalidate_cb(int cb, asid_t asid)
@@ -592,32 +618,69 @@ void smmu_tlb_invalidate_cb(int cb, asid_t asid)
      * context bnak number.*/
     uint32_t reg = TLBIVMID_SET(cb);
     smmu_write_reg32(SMMU_GR0_PPTR, SMMU_TLBIVMID, reg);
-    smmu_tlb_sync(SMMU_GR0_PPTR, SMMU_sTLBGSYNC, SMMU_sTLBGSTATUS);
+    smmu_global_tlb_sync();
 #else
     /*stage 1*/
     uint32_t reg = CBn_TLBIASID_SET(asid);
     smmu_write_reg32(SMMU_CBn_BASE_PPTR(cb), SMMU_CBn_TLBIASID, reg);
-    smmu_tlb_sync(SMMU_CBn_BASE_PPTR(cb), SMMU_CBn_TLBSYNC, SMMU_CBn_TLBSTATUS);
+    smmu_cb_tlb_sync(cb);
 #endif
 }
 
 void smmu_tlb_invalidate_cb_va(int cb, asid_t asid, vptr_t vaddr)
 {
+    smmu_tlb_invalidate_cb_range(cb, asid, vaddr, 1, seL4_PageBits);
+}
+
+void smmu_tlb_invalidate_cb_range(int cb, asid_t asid, vptr_t vaddr, word_t npages, word_t pageBits)
+{
+    /*past the threshold, one invalidation of the whole ASID (VMID) is cheaper
+    than invalidating each page*/
+    if (npages > CONFIG_ARM_SMMU_TLBI_RANGE_MAX) {
+        smmu_tlb_invalidate_cb(cb, asid);
+        return;
+    }
+
+    /*callers only replace or remove leaf entries, so the last level (L)
+    variants are used, which leave cached intermediate table walks intact*/
+    for (word_t i = 0; i < npages; i++) {
+        vptr_t va = vaddr + (i << pageBits);
 #ifdef CONFIG_ARM_HYPERVISOR_SUPPORT
-    /*stage 2*/
-    /* invalidate all unlocated TLB entries in the stage 2 translation
-    * associated with the given IPA*/
-    uint64_t reg = CBn_TLBIIPAS2_SET(vaddr);
-    smmu_write_reg64(SMMU_CBn_BASE_PPTR(cb), SMMU_CBn_TLBIIPAS2, reg);
-    smmu_tlb_sync(SMMU_CBn_BASE_PPTR(cb), SMMU_CBn_TLBSYNC, SMMU_CBn_TLBSTATUS);
+        /*stage 2*/
+        /* invalidate all unlocated TLB entries in the stage 2 translation
+        * associated with the given IPA*/
+        uint64_t reg = CBn_TLBIIPAS2_SET(va);
+        smmu_write_reg64(SMMU_CBn_BASE_PPTR(cb), SMMU_CBn_TLBIIPAS2L, reg);
 #else
-    /*stage 1*/
-    uint64_t reg = CBn_TLBIVA_SET(asid, vaddr);
-    smmu_write_reg64(SMMU_CBn_BASE_PPTR(cb), SMMU_CBn_TLBIVA, reg);
-    smmu_tlb_sync(SMMU_CBn_BASE_PPTR(cb), SMMU_CBn_TLBSYNC, SMMU_CBn_TLBSTATUS);
+        /*stage 1*/
+        uint64_t reg = CBn_TLBIVA_SET(asid, va);
+        smmu_write_reg64(SMMU_CBn_BASE_PPTR(cb), SMMU_CBn_TLBIVAL, reg);
 #endif
+    }
+    smmu_cb_tlb_sync(cb);
 }
 
+#ifdef CONFIG_ARM_SMMU_DEFER_TLB_SYNC
+void smmu_tlb_sync_deferred(void)
+{
+    if (likely(!smmu_sync_pending)) {
+        return;
+    }
+
+    if (smmu_global_sync_pending) {
+        smmu_tlb_sync(SMMU_GR0_PPTR, SMMU_sTLBGSYNC, SMMU_sTLBGSTATUS);
+        smmu_global_sync_pending = false;
+    }
+    for (int cb = 0; cb < SMMU_MAX_CB; cb++) {
+        if (smmu_cb_sync_pending[cb]) {
+            smmu_tlb_sync(SMMU_CBn_BASE_PPTR(cb), SMMU_CBn_TLBSYNC, SMMU_CBn_TLBSTATUS);
+            smmu_cb_sync_pending[cb] = false;
+        }
+    }
+    smmu_sync_pending = false;
+}
+#endif
+
 void smmu_read_fault_state(uint32_t *status, uint32_t *syndrome_0, uint32_t *syndrome_1)
 {
     *status = smmu_read_reg32(SMMU_GR0_PPTR, SMMU_sGFSR);
@@ -109,3 +109,15 @@ config_option(
     DEFAULT ON
     DEPENDS "KernelArmHypervisorSupport"
 )
+
+config_option(
+    KernelArmHypVCPUResident ARM_HYP_VCPU_RESIDENT
+    "Leave the virtual timer of a VCPU loaded while a native thread or the \
+    idle thread runs, with its interrupt masked. The timer is only saved and \
+    restored when a different VCPU is switched to, so a VCPU that resumes \
+    after a native thread only has its timer interrupt unmasked and, with \
+    KernelArmVtimerUpdateVOffset, its offset adjusted."
+    DEFAULT OFF
+    DEPENDS "KernelArmHypervisorSupport;NOT KernelArmExportVTMRUser;NOT KernelVerificationBuild"
+    DEFAULT_DISABLED OFF
+)
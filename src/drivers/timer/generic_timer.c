@@ -135,4 +135,76 @@ static void restore_virt_timer(vcpu_t *vcpu)
     vcpu_restore_reg(vcpu, seL4_VCPUReg_CNTV_CTL);
 }
 
+#ifdef CONFIG_ARM_HYP_VCPU_RESIDENT
+/* While a native thread runs, the virtual timer of the VCPU is left in the
+ * hardware, with its interrupt masked. Only the EL0 access control has to
+ * change for native threads. */
+static void pause_virt_timer(vcpu_t *vcpu)
+{
+#ifdef CONFIG_ARCH_AARCH64
+    vcpu_save_reg(vcpu, seL4_VCPUReg_CNTKCTL_EL1);
+    check_export_arch_timer();
+#endif
+#ifdef CONFIG_VTIMER_UPDATE_VOFFSET
+    vcpu->virtTimer.last_pcount = read_cntpct();
+#endif
+}
+
+static void resume_virt_timer(vcpu_t *vcpu)
+{
+#ifdef CONFIG_ARCH_AARCH64
+    vcpu_restore_reg(vcpu, seL4_VCPUReg_CNTKCTL_EL1);
+#endif
+#ifdef CONFIG_VTIMER_UPDATE_VOFFSET
+    uint64_t pcount_delta = read_cntpct() - vcpu->virtTimer.last_pcount;
+#ifdef CONFIG_ARCH_AARCH64
+    vcpu_hw_write_reg(seL4_VCPUReg_CNTVOFF, vcpu_hw_read_reg(seL4_VCPUReg_CNTVOFF) + pcount_delta);
+#else
+    set_cntv_off_64(get_cntv_off_64() + pcount_delta);
+#endif
+#endif
+    if (likely(isIRQActive(CORE_IRQ_TO_IRQT(CURRENT_CPU_INDEX(), INTERRUPT_VTIMER_EVENT)))) {
+        maskInterrupt(vcpu->vppi_masked[irqVPPIEventIndex(CORE_IRQ_TO_IRQT(CURRENT_CPU_INDEX(), INTERRUPT_VTIMER_EVENT))],
+                      CORE_IRQ_TO_IRQT(CURRENT_CPU_INDEX(), INTERRUPT_VTIMER_EVENT));
+    }
+}
+
+/* Save the part of the timer state pause_virt_timer left in the hardware,
+ * when the paused VCPU is switched out */
+static void evict_virt_timer(vcpu_t *vcpu)
+{
+    vcpu_save_reg(vcpu, seL4_VCPUReg_CNTV_CTL);
+    vcpu_hw_write_reg(seL4_VCPUReg_CNTV_CTL, 0);
+#ifdef CONFIG_ARCH_AARCH64
+    vcpu_save_reg(vcpu, seL4_VCPUReg_CNTV_CVAL);
+    vcpu_save_reg(vcpu, seL4_VCPUReg_CNTVOFF);
+#else
+    uint64_t cval = get_cntv_cval_64();
+    uint64_t cntvoff = get_cntv_off_64();
+    vcpu_write_reg(vcpu, seL4_VCPUReg_CNTV_CVALhigh, (word_t)(cval >> 32));
+    vcpu_write_reg(vcpu, seL4_VCPUReg_CNTV_CVALlow, (word_t)cval);
+    vcpu_write_reg(vcpu, seL4_VCPUReg_CNTVOFFhigh, (word_t)(cntvoff >> 32));
+    vcpu_write_reg(vcpu, seL4_VCPUReg_CNTVOFFlow, (word_t)cntvoff);
+#endif
+}
+
+/* Load the part of the timer state resume_virt_timer expects in the hardware,
+ * before a VCPU is switched in */
+static void load_virt_timer(vcpu_t *vcpu)
+{
+#ifdef CONFIG_ARCH_AARCH64
+    vcpu_restore_reg(vcpu, seL4_VCPUReg_CNTV_CVAL);
+    vcpu_restore_reg(vcpu, seL4_VCPUReg_CNTVOFF);
+#else
+    uint32_t cval_high = vcpu_read_reg(vcpu, seL4_VCPUReg_CNTV_CVALhigh);
+    uint32_t cval_low = vcpu_read_reg(vcpu, seL4_VCPUReg_CNTV_CVALlow);
+    set_cntv_cval_64(((uint64_t)cval_high << 32) | (uint64_t) cval_low);
+    uint32_t offset_high = vcpu_read_reg(vcpu, seL4_VCPUReg_CNTVOFFhigh);
+    uint32_t offset_low = vcpu_read_reg(vcpu, seL4_VCPUReg_CNTVOFFlow);
+    set_cntv_off_64(((uint64_t)offset_high << 32) | (uint64_t) offset_low);
+#endif
+    vcpu_restore_reg(vcpu, seL4_VCPUReg_CNTV_CTL);
+}
+#endif /* CONFIG_ARM_HYP_VCPU_RESIDENT */
+
 #endif /* CONFIG_ARM_HYPERVISOR_SUPPORT */
@@ -39,7 +39,7 @@ void NORETURN fastpath_call(word_t cptr, word_t msgInfo)
      * saved fault. */
     if (unlikely(fastpath_mi_check(msgInfo) ||
                  fault_type != seL4_Fault_NullFault)) {
-        slowpath(SysCall);
+        fastpath_miss(SysCall, MSGINFO);
     }
 
     /* Lookup the cap */
@@ -48,7 +48,7 @@ void NORETURN fastpath_call(word_t cptr, word_t msgInfo)
     /* Check it's an endpoint */
     if (unlikely(!cap_capType_equals(ep_cap, cap_endpoint_cap) ||
                  !cap_endpoint_cap_get_capCanSend(ep_cap))) {
-        slowpath(SysCall);
+        fastpath_miss(SysCall, CAP);
     }
 
     /* Get the endpoint address */
@@ -60,13 +60,13 @@ void NORETURN fastpath_call(word_t cptr, word_t msgInfo)
 
     /* Check that there's a thread waiting to receive */
     if (unlikely(endpoint_ptr_get_state(ep_ptr) != EPState_Recv)) {
-        slowpath(SysCall);
+        fastpath_miss(SysCall, EP_STATE);
     }
 
     /* ensure we are not single stepping the destination in ia32 */
 #if defined(CONFIG_HARDWARE_DEBUG_API) && defined(CONFIG_ARCH_IA32)
     if (unlikely(dest->tcbArch.tcbContext.breakpointState.single_step_enabled)) {
-        slowpath(SysCall);
+        fastpath_miss(SysCall, DEBUG);
     }
 #endif
 
@@ -78,7 +78,7 @@ void NORETURN fastpath_call(word_t cptr, word_t msgInfo)
 
     /* Ensure that the destination has a valid VTable. */
     if (unlikely(! isValidVTableRoot_fp(newVTable))) {
-        slowpath(SysCall);
+        fastpath_miss(SysCall, VSPACE);
     }
 
 #ifdef CONFIG_ARCH_AARCH32
@@ -101,12 +101,12 @@ void NORETURN fastpath_call(word_t cptr, word_t msgInfo)
     asid_map_t asid_map = findMapForASID(asid);
     if (unlikely(asid_map_get_type(asid_map) != asid_map_asid_map_vspace ||
                  VSPACE_PTR(asid_map_asid_map_vspace_get_vspace_root(asid_map)) != cap_pd)) {
-        slowpath(SysCall);
+        fastpath_miss(SysCall, ASID);
     }
 #ifdef CONFIG_ARM_HYPERVISOR_SUPPORT
     /* Ensure the vmid is valid. */
     if (unlikely(!asid_map_asid_map_vspace_get_stored_vmid_valid(asid_map))) {
-        slowpath(SysCall);
+        fastpath_miss(SysCall, ASID);
     }
     /* vmids are the tags used instead of hw_asids in hyp mode */
     stored_hw_asid.words[0] = asid_map_asid_map_vspace_get_stored_hw_vmid(asid_map);
@@ -117,7 +117,14 @@ void NORETURN fastpath_call(word_t cptr, word_t msgInfo)
 
 #ifdef CONFIG_ARCH_RISCV
     /* Get HW ASID */
+#ifdef CONFIG_RISCV_HW_ASID_ALLOCATOR
+    stored_hw_asid.words[0] = getHWASID_fp(cap_page_table_cap_get_capPTMappedASID(newVTable), cap_pd);
+    if (unlikely(stored_hw_asid.words[0] == 0 && riscvKSHWASIDBits != 0)) {
+        fastpath_miss(SysCall, ASID);
+    }
+#else
     stored_hw_asid.words[0] = cap_page_table_cap_get_capPTMappedASID(newVTable);
+#endif
 #endif
 
     /* let gcc optimise this out for 1 domain */
@@ -125,42 +132,42 @@ void NORETURN fastpath_call(word_t cptr, word_t msgInfo)
     /* ensure only the idle thread or lower prio threads are present in the scheduler */
     if (unlikely(dest->tcbPriority < NODE_STATE(ksCurThread->tcbPriority) &&
                  !isHighestPrio(dom, dest->tcbPriority))) {
-        slowpath(SysCall);
+        fastpath_miss(SysCall, PRIORITY);
     }
 
     /* Ensure that the endpoint has has grant or grant-reply rights so that we can
      * create the reply cap */
     if (unlikely(!cap_endpoint_cap_get_capCanGrant(ep_cap) &&
                  !cap_endpoint_cap_get_capCanGrantReply(ep_cap))) {
-        slowpath(SysCall);
+        fastpath_miss(SysCall, GRANT);
     }
 
 #ifdef CONFIG_ARCH_AARCH32
     if (unlikely(!pde_pde_invalid_get_stored_asid_valid(stored_hw_asid))) {
-        slowpath(SysCall);
+        fastpath_miss(SysCall, ASID);
     }
 #endif
 
     /* Ensure the original caller is in the current domain and can be scheduled directly. */
     if (unlikely(dest->tcbDomain != ksCurDomain && 0 < maxDom)) {
-        slowpath(SysCall);
+        fastpath_miss(SysCall, DOMAIN);
     }
 
 #ifdef CONFIG_KERNEL_MCS
     if (unlikely(dest->tcbSchedContext != NULL)) {
-        slowpath(SysCall);
+        fastpath_miss(SysCall, SCHED_CONTEXT);
     }
 
     reply_t *reply = thread_state_get_replyObject_np(dest->tcbState);
     if (unlikely(reply == NULL)) {
-        slowpath(SysCall);
+        fastpath_miss(SysCall, REPLY);
     }
 #endif
 
 #ifdef ENABLE_SMP_SUPPORT
     /* Ensure both threads have the same affinity */
     if (unlikely(NODE_STATE(ksCurThread)->tcbAffinity != dest->tcbAffinity)) {
-        slowpath(SysCall);
+        fastpath_miss(SysCall, AFFINITY);
     }
 #endif /* ENABLE_SMP_SUPPORT */
 
@@ -173,6 +180,7 @@ void NORETURN fastpath_call(word_t cptr, word_t msgInfo)
 #ifdef CONFIG_BENCHMARK_TRACK_KERNEL_ENTRIES
     ksKernelEntry.is_fastpath = true;
 #endif
+    FASTPATH_COUNT(SysCall, BENCHMARK_FASTPATH_HIT);
 
     /* Dequeue the destination. */
     endpoint_ptr_set_epQueue_head_np(ep_ptr, TCB_REF(dest->tcbEPNext));
@@ -225,6 +233,7 @@ void NORETURN fastpath_call(word_t cptr, word_t msgInfo)
     /* Dest thread is set Running, but not queued. */
     thread_state_ptr_set_tsType_np(&dest->tcbState,
                                    ThreadState_Running);
+    FASTPATH_SCHED_SWITCH(dest);
     switchToThread_fp(dest, cap_pd, stored_hw_asid);
 
     msgInfo = wordFromMessageInfo(seL4_MessageInfo_set_capsUnwrapped(info, 0));
@@ -265,7 +274,7 @@ void NORETURN fastpath_reply_recv(word_t cptr, word_t msgInfo)
      * saved fault. */
     if (unlikely(fastpath_mi_check(msgInfo) ||
                  fault_type != seL4_Fault_NullFault)) {
-        slowpath(SysReplyRecv);
+        fastpath_miss(SysReplyRecv, MSGINFO);
     }
 
     /* Lookup the cap */
@@ -275,7 +284,7 @@ void NORETURN fastpath_reply_recv(word_t cptr, word_t msgInfo)
     /* Check it's an endpoint */
     if (unlikely(!cap_capType_equals(ep_cap, cap_endpoint_cap) ||
                  !cap_endpoint_cap_get_capCanReceive(ep_cap))) {
-        slowpath(SysReplyRecv);
+        fastpath_miss(SysReplyRecv, CAP);
     }
 
 #ifdef CONFIG_KERNEL_MCS
@@ -284,14 +293,14 @@ void NORETURN fastpath_reply_recv(word_t cptr, word_t msgInfo)
 
     /* check it's a reply object */
     if (unlikely(!cap_capType_equals(reply_cap, cap_reply_cap))) {
-        slowpath(SysReplyRecv);
+        fastpath_miss(SysReplyRecv, REPLY);
     }
 #endif
 
     /* Check there is nothing waiting on the notification */
     if (unlikely(NODE_STATE(ksCurThread)->tcbBoundNotification &&
                  notification_ptr_get_state(NODE_STATE(ksCurThread)->tcbBoundNotification) == NtfnState_Active)) {
-        slowpath(SysReplyRecv);
+        fastpath_miss(SysReplyRecv, NTFN);
     }
 
     /* Get the endpoint address */
@@ -299,7 +308,7 @@ void NORETURN fastpath_reply_recv(word_t cptr, word_t msgInfo)
 
     /* Check that there's not a thread waiting to send */
     if (unlikely(endpoint_ptr_get_state(ep_ptr) == EPState_Send)) {
-        slowpath(SysReplyRecv);
+        fastpath_miss(SysReplyRecv, EP_STATE);
     }
 
 #ifdef CONFIG_KERNEL_MCS
@@ -310,7 +319,7 @@ void NORETURN fastpath_reply_recv(word_t cptr, word_t msgInfo)
     if (unlikely(reply_ptr->replyTCB == NULL ||
                  call_stack_get_isHead(reply_ptr->replyNext) == 0 ||
                  SC_PTR(call_stack_get_callStackPtr(reply_ptr->replyNext)) != NODE_STATE(ksCurThread)->tcbSchedContext)) {
-        slowpath(SysReplyRecv);
+        fastpath_miss(SysReplyRecv, REPLY);
     }
 
     /* Determine who the caller is. */
@@ -320,7 +329,7 @@ void NORETURN fastpath_reply_recv(word_t cptr, word_t msgInfo)
     cte_t *callerSlot = TCB_PTR_CTE_PTR(NODE_STATE(ksCurThread), tcbCaller);
     cap_t callerCap = callerSlot->cap;
     if (unlikely(!fastpath_reply_cap_check(callerCap))) {
-        slowpath(SysReplyRecv);
+        fastpath_miss(SysReplyRecv, REPLY);
     }
 
     /* Determine who the caller is. */
@@ -330,7 +339,7 @@ void NORETURN fastpath_reply_recv(word_t cptr, word_t msgInfo)
     /* ensure we are not single stepping the caller in ia32 */
 #if defined(CONFIG_HARDWARE_DEBUG_API) && defined(CONFIG_ARCH_IA32)
     if (unlikely(caller->tcbArch.tcbContext.breakpointState.single_step_enabled)) {
-        slowpath(SysReplyRecv);
+        fastpath_miss(SysReplyRecv, DEBUG);
     }
 #endif
 
@@ -341,11 +350,11 @@ void NORETURN fastpath_reply_recv(word_t cptr, word_t msgInfo)
     /* Change this as more types of faults are supported */
 #ifndef CONFIG_EXCEPTION_FASTPATH
     if (unlikely(fault_type != seL4_Fault_NullFault)) {
-        slowpath(SysReplyRecv);
+        fastpath_miss(SysReplyRecv, FAULT);
     }
 #else
     if (unlikely(fault_type != seL4_Fault_NullFault && fault_type != seL4_Fault_VMFault)) {
-        slowpath(SysReplyRecv);
+        fastpath_miss(SysReplyRecv, FAULT);
     }
 #endif
 
@@ -357,7 +366,7 @@ void NORETURN fastpath_reply_recv(word_t cptr, word_t msgInfo)
 
     /* Ensure that the destination has a valid MMU. */
     if (unlikely(! isValidVTableRoot_fp(newVTable))) {
-        slowpath(SysReplyRecv);
+        fastpath_miss(SysReplyRecv, VSPACE);
     }
 
 #ifdef CONFIG_ARCH_AARCH32
@@ -378,12 +387,12 @@ void NORETURN fastpath_reply_recv(word_t cptr, word_t msgInfo)
     asid_map_t asid_map = findMapForASID(asid);
     if (unlikely(asid_map_get_type(asid_map) != asid_map_asid_map_vspace ||
                  VSPACE_PTR(asid_map_asid_map_vspace_get_vspace_root(asid_map)) != cap_pd)) {
-        slowpath(SysReplyRecv);
+        fastpath_miss(SysReplyRecv, ASID);
     }
 #ifdef CONFIG_ARM_HYPERVISOR_SUPPORT
     /* Ensure the vmid is valid. */
     if (unlikely(!asid_map_asid_map_vspace_get_stored_vmid_valid(asid_map))) {
-        slowpath(SysReplyRecv);
+        fastpath_miss(SysReplyRecv, ASID);
     }
 
     /* vmids are the tags used instead of hw_asids in hyp mode */
@@ -394,37 +403,44 @@ void NORETURN fastpath_reply_recv(word_t cptr, word_t msgInfo)
 #endif
 
 #ifdef CONFIG_ARCH_RISCV
+#ifdef CONFIG_RISCV_HW_ASID_ALLOCATOR
+    stored_hw_asid.words[0] = getHWASID_fp(cap_page_table_cap_get_capPTMappedASID(newVTable), cap_pd);
+    if (unlikely(stored_hw_asid.words[0] == 0 && riscvKSHWASIDBits != 0)) {
+        fastpath_miss(SysReplyRecv, ASID);
+    }
+#else
     stored_hw_asid.words[0] = cap_page_table_cap_get_capPTMappedASID(newVTable);
+#endif
 #endif
 
     /* Ensure the original caller can be scheduled directly. */
     dom = maxDom ? ksCurDomain : 0;
     if (unlikely(!isHighestPrio(dom, caller->tcbPriority))) {
-        slowpath(SysReplyRecv);
+        fastpath_miss(SysReplyRecv, PRIORITY);
     }
 
 #ifdef CONFIG_ARCH_AARCH32
     /* Ensure the HWASID is valid. */
     if (unlikely(!pde_pde_invalid_get_stored_asid_valid(stored_hw_asid))) {
-        slowpath(SysReplyRecv);
+        fastpath_miss(SysReplyRecv, ASID);
     }
 #endif
 
     /* Ensure the original caller is in the current domain and can be scheduled directly. */
     if (unlikely(caller->tcbDomain != ksCurDomain && 0 < maxDom)) {
-        slowpath(SysReplyRecv);
+        fastpath_miss(SysReplyRecv, DOMAIN);
     }
 
 #ifdef CONFIG_KERNEL_MCS
     if (unlikely(caller->tcbSchedContext != NULL)) {
-        slowpath(SysReplyRecv);
+        fastpath_miss(SysReplyRecv, SCHED_CONTEXT);
     }
 #endif
 
 #ifdef ENABLE_SMP_SUPPORT
     /* Ensure both threads have the same affinity */
     if (unlikely(NODE_STATE(ksCurThread)->tcbAffinity != caller->tcbAffinity)) {
-        slowpath(SysReplyRecv);
+        fastpath_miss(SysReplyRecv, AFFINITY);
     }
 #endif /* ENABLE_SMP_SUPPORT */
 
@@ -442,6 +458,7 @@ void NORETURN fastpath_reply_recv(word_t cptr, word_t msgInfo)
 #ifdef CONFIG_BENCHMARK_TRACK_KERNEL_ENTRIES
     ksKernelEntry.is_fastpath = true;
 #endif
+    FASTPATH_COUNT(SysReplyRecv, BENCHMARK_FASTPATH_HIT);
 
     /* Set thread state to BlockedOnReceive */
     thread_state_ptr_mset_blockingObject_tsType(
@@ -529,6 +546,7 @@ void NORETURN fastpath_reply_recv(word_t cptr, word_t msgInfo)
 
         /* Dest thread is set Running, but not queued. */
         thread_state_ptr_set_tsType_np(&caller->tcbState, ThreadState_Running);
+        FASTPATH_SCHED_SWITCH(caller);
         switchToThread_fp(caller, cap_pd, stored_hw_asid);
 
         /* The badge/msginfo do not need to be not sent - this is not necessary for exceptions */
@@ -544,6 +562,7 @@ void NORETURN fastpath_reply_recv(word_t cptr, word_t msgInfo)
 
         /* Dest thread is set Running, but not queued. */
         thread_state_ptr_set_tsType_np(&caller->tcbState, ThreadState_Running);
+        FASTPATH_SCHED_SWITCH(caller);
         switchToThread_fp(caller, cap_pd, stored_hw_asid);
 
         msgInfo = wordFromMessageInfo(seL4_MessageInfo_set_capsUnwrapped(info, 0));
@@ -575,7 +594,7 @@ void NORETURN fastpath_signal(word_t cptr, word_t msgInfo)
     /* Check there's no saved fault. Can be removed if the current thread can't
      * have a fault while invoking the fastpath */
     if (unlikely(fault_type != seL4_Fault_NullFault)) {
-        slowpath(SysSend);
+        fastpath_miss(SysSend, MSGINFO);
     }
 
     /* Lookup the cap */
@@ -583,17 +602,17 @@ void NORETURN fastpath_signal(word_t cptr, word_t msgInfo)
 
     /* Check it's a notification */
     if (unlikely(!cap_capType_equals(cap, cap_notification_cap))) {
-        slowpath(SysSend);
+        fastpath_miss(SysSend, CAP);
     }
 
     /* Check that we are allowed to send to this cap */
     if (unlikely(!cap_notification_cap_get_capNtfnCanSend(cap))) {
-        slowpath(SysSend);
+        fastpath_miss(SysSend, CAP);
     }
 
     /* Check that the current domain hasn't expired */
     if (unlikely(isCurDomainExpired())) {
-        slowpath(SysSend);
+        fastpath_miss(SysSend, DOMAIN);
     }
 
     /* Get the notification address */
@@ -609,6 +628,7 @@ void NORETURN fastpath_signal(word_t cptr, word_t msgInfo)
 #ifdef CONFIG_BENCHMARK_TRACK_KERNEL_ENTRIES
         ksKernelEntry.is_fastpath = true;
 #endif
+        FASTPATH_COUNT(SysSend, BENCHMARK_FASTPATH_HIT);
         ntfn_set_active(ntfnPtr, badge | notification_ptr_get_ntfnMsgIdentifier(ntfnPtr));
         restore_user_context();
         UNREACHABLE();
@@ -619,6 +639,7 @@ void NORETURN fastpath_signal(word_t cptr, word_t msgInfo)
 #ifdef CONFIG_BENCHMARK_TRACK_KERNEL_ENTRIES
             ksKernelEntry.is_fastpath = true;
 #endif
+            FASTPATH_COUNT(SysSend, BENCHMARK_FASTPATH_HIT);
             ntfn_set_active(ntfnPtr, badge);
             restore_user_context();
             UNREACHABLE();
@@ -641,13 +662,13 @@ void NORETURN fastpath_signal(word_t cptr, word_t msgInfo)
     if (!sc) {
         sc = SC_PTR(notification_ptr_get_ntfnSchedContext(ntfnPtr));
         if (sc == NULL || sc->scTcb != NULL) {
-            slowpath(SysSend);
+            fastpath_miss(SysSend, SCHED_CONTEXT);
         }
 
         /* Slowpath the case where dest has its FPU context in the FPU of a core*/
 #if defined(ENABLE_SMP_SUPPORT) && defined(CONFIG_HAVE_FPU)
         if (nativeThreadUsingFPU(dest)) {
-            slowpath(SysSend);
+            fastpath_miss(SysSend, FPU);
         }
 #endif
     }
@@ -655,7 +676,7 @@ void NORETURN fastpath_signal(word_t cptr, word_t msgInfo)
     /* Only fastpath signal to threads which will not become the new highest prio thread on the
      * core of their SC, even if the currently running thread on the core is the idle thread. */
     if (NODE_STATE_ON_CORE(ksCurThread, sc->scCore)->tcbPriority < dest->tcbPriority) {
-        slowpath(SysSend);
+        fastpath_miss(SysSend, PRIORITY);
     }
 
     /* Simplified schedContext_resume that does not change state and reverts to the
@@ -665,7 +686,7 @@ void NORETURN fastpath_signal(word_t cptr, word_t msgInfo)
      * that will affect the conditions of this check */
     if (sc->scRefillMax > 0) {
         if (!(refill_ready(sc) && refill_sufficient(sc, 0))) {
-            slowpath(SysSend);
+            fastpath_miss(SysSend, BUDGET);
         }
         schedulable = true;
     }
@@ -679,6 +700,7 @@ void NORETURN fastpath_signal(word_t cptr, word_t msgInfo)
 #ifdef CONFIG_BENCHMARK_TRACK_KERNEL_ENTRIES
     ksKernelEntry.is_fastpath = true;
 #endif
+    FASTPATH_COUNT(SysSend, BENCHMARK_FASTPATH_HIT);
 
     if (idle) {
         /* Cancel the IPC that the signalled thread is waiting on */
@@ -691,6 +713,7 @@ void NORETURN fastpath_signal(word_t cptr, word_t msgInfo)
     /* Wake up the signalled thread and tranfer badge */
     setRegister(dest, badgeRegister, badge);
     thread_state_ptr_set_tsType_np(&dest->tcbState, ThreadState_Running);
+    FASTPATH_SCHED_WAKE(dest);
 
     /* Donate SC if necessary. The checks for this were already done before
      * the point of no return */
@@ -896,6 +919,7 @@ void NORETURN fastpath_vm_fault(vm_fault_type_t type)
 
     /* Set the fault handler to running */
     thread_state_ptr_set_tsType_np(&dest->tcbState, ThreadState_Running);
+    FASTPATH_SCHED_SWITCH(dest);
     switchToThread_fp(dest, cap_pd, stored_hw_asid);
     msgInfo = wordFromMessageInfo(seL4_MessageInfo_set_capsUnwrapped(info, 0));
 
@@ -193,3 +193,65 @@ resolveAddressBits_ret_t resolveAddressBits(cap_t nodeCap, cptr_t capptr, word_t
 
     UNREACHABLE();
 }
+
+#ifdef CONFIG_FRAME_MAP_RANGE
+/* Look up a window of nodeWindow consecutive source slots starting at
+ * nodeOffset in the CNode addressed by root, nodeIndex and nodeDepth. */
+lookupSlotWindow_ret_t lookupSourceWindow(cap_t root, cptr_t nodeIndex,
+                                          word_t nodeDepth, word_t nodeOffset,
+                                          word_t nodeWindow, word_t maxWindow)
+{
+    lookupSlotWindow_ret_t ret;
+    lookupSlot_ret_t lu_ret;
+    cap_t nodeCap;
+    word_t nodeSize;
+
+    ret.window = NULL;
+
+    if (nodeDepth == 0) {
+        nodeCap = root;
+    } else {
+        lu_ret = lookupSourceSlot(root, nodeIndex, nodeDepth);
+        if (lu_ret.status != EXCEPTION_NONE) {
+            ret.status = lu_ret.status;
+            return ret;
+        }
+        nodeCap = lu_ret.slot->cap;
+    }
+
+    if (cap_get_capType(nodeCap) != cap_cnode_cap) {
+        current_syscall_error.type = seL4_FailedLookup;
+        current_syscall_error.failedLookupWasSource = 1;
+        current_lookup_fault = lookup_fault_missing_capability_new(nodeDepth);
+        ret.status = EXCEPTION_SYSCALL_ERROR;
+        return ret;
+    }
+
+    nodeSize = BIT(cap_cnode_cap_get_capCNodeRadix(nodeCap));
+    if (nodeOffset > nodeSize - 1) {
+        current_syscall_error.type = seL4_RangeError;
+        current_syscall_error.rangeErrorMin = 0;
+        current_syscall_error.rangeErrorMax = nodeSize - 1;
+        ret.status = EXCEPTION_SYSCALL_ERROR;
+        return ret;
+    }
+    if (nodeWindow < 1 || nodeWindow > maxWindow) {
+        current_syscall_error.type = seL4_RangeError;
+        current_syscall_error.rangeErrorMin = 1;
+        current_syscall_error.rangeErrorMax = maxWindow;
+        ret.status = EXCEPTION_SYSCALL_ERROR;
+        return ret;
+    }
+    if (nodeWindow > nodeSize - nodeOffset) {
+        current_syscall_error.type = seL4_RangeError;
+        current_syscall_error.rangeErrorMin = 1;
+        current_syscall_error.rangeErrorMax = nodeSize - nodeOffset;
+        ret.status = EXCEPTION_SYSCALL_ERROR;
+        return ret;
+    }
+
+    ret.window = CTE_PTR(cap_cnode_cap_get_capCNodePtr(nodeCap)) + nodeOffset;
+    ret.status = EXCEPTION_NONE;
+    return ret;
+}
+#endif
@@ -16,6 +16,7 @@
 #include <object/schedcontext.h>
 #endif
 #include <model/statedata.h>
+#include <benchmark/benchmark_sched.h>
 #include <arch/machine.h>
 #include <arch/kernel/thread.h>
 #include <machine/registerset.h>
@@ -310,6 +311,9 @@ static void nextDomain(void)
 #endif
     ksWorkUnitsCompleted = 0;
     ksCurDomain = ksDomSchedule[ksDomScheduleIdx].domain;
+#ifdef CONFIG_BENCHMARK_SCHED_TRACE
+    benchmark_sched_record(BENCHMARK_SCHED_DOMAIN, NULL, ksCurDomain);
+#endif
 #ifdef CONFIG_KERNEL_MCS
     ksDomainTime = usToTicks(ksDomSchedule[ksDomScheduleIdx].length * US_IN_MS);
 #else
@@ -449,6 +453,9 @@ void switchToThread(tcb_t *thread)
 
 #ifdef CONFIG_BENCHMARK_TRACK_UTILISATION
     benchmark_utilisation_switch(NODE_STATE(ksCurThread), thread);
+#endif
+#ifdef CONFIG_BENCHMARK_SCHED_TRACE
+    benchmark_sched_record(BENCHMARK_SCHED_SWITCH, thread, thread->tcbPriority);
 #endif
     Arch_switchToThread(thread);
     tcbSchedDequeue(thread);
@@ -459,6 +466,9 @@ void switchToIdleThread(void)
 {
 #ifdef CONFIG_BENCHMARK_TRACK_UTILISATION
     benchmark_utilisation_switch(NODE_STATE(ksCurThread), NODE_STATE(ksIdleThread));
+#endif
+#ifdef CONFIG_BENCHMARK_SCHED_TRACE
+    benchmark_sched_record(BENCHMARK_SCHED_SWITCH, NODE_STATE(ksIdleThread), -1);
 #endif
     Arch_switchToIdleThread();
     NODE_STATE(ksCurThread) = NODE_STATE(ksIdleThread);
@@ -551,6 +561,9 @@ void possibleSwitchTo(tcb_t *target)
 
 void setThreadState(tcb_t *tptr, _thread_state_t ts)
 {
+#ifdef CONFIG_BENCHMARK_SCHED_TRACE
+    benchmark_sched_state(tptr, ts);
+#endif
     thread_state_ptr_set_tsType(&tptr->tcbState, ts);
     scheduleTCB(tptr);
 }
@@ -572,6 +585,9 @@ void postpone(sched_context_t *sc)
 
     tcbSchedDequeue(tcb);
     tcbReleaseEnqueue(tcb);
+#ifdef CONFIG_BENCHMARK_SCHED_TRACE
+    benchmark_sched_record(BENCHMARK_SCHED_POSTPONE, tcb, refill_head(sc)->rTime);
+#endif
     NODE_STATE_ON_CORE(ksReprogram, sc->scCore) = true;
 }
 
@@ -600,6 +616,9 @@ void setNextInterrupt(void)
 
 void chargeBudget(ticks_t consumed, bool_t canTimeoutFault)
 {
+#ifdef CONFIG_BENCHMARK_SCHED_TRACE
+    benchmark_sched_record(BENCHMARK_SCHED_BUDGET, NODE_STATE(ksCurThread), consumed);
+#endif
     if (likely(NODE_STATE(ksCurSC) != NODE_STATE(ksIdleSC))) {
         if (isRoundRobin(NODE_STATE(ksCurSC))) {
             assert(refill_size(NODE_STATE(ksCurSC)) == MIN_REFILLS);
@@ -611,6 +630,9 @@ void chargeBudget(ticks_t consumed, bool_t canTimeoutFault)
 
         assert(refill_head(NODE_STATE(ksCurSC))->rAmount >= MIN_BUDGET);
         NODE_STATE(ksCurSC)->scConsumed += consumed;
+#ifdef CONFIG_BENCHMARK_TRACK_UTILISATION
+        benchmark_utilisation_consumed(consumed);
+#endif
     }
     NODE_STATE(ksConsumed) = 0;
     if (likely(isSchedulable(NODE_STATE(ksCurThread)))) {
@@ -704,6 +726,9 @@ static void tcbReleaseDequeue(void)
     SMP_COND_STATEMENT(assert(awakened->tcbAffinity == getCurrentCPUIndex()));
     /* threads HEAD refill should always be >= MIN_BUDGET */
     assert(refill_sufficient(awakened->tcbSchedContext, 0));
+#ifdef CONFIG_BENCHMARK_SCHED_TRACE
+    benchmark_sched_record(BENCHMARK_SCHED_RELEASE, awakened, 0);
+#endif
     possibleSwitchTo(awakened);
 }
 
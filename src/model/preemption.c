@@ -9,6 +9,7 @@
 #include <model/statedata.h>
 #include <plat/machine/hardware.h>
 #include <config.h>
+#include <benchmark/benchmark_preemption.h>
 
 /*
  * Possibly preempt the current thread to allow an interrupt to be handled.
@@ -17,6 +18,9 @@ exception_t preemptionPoint(void)
 {
     /* Record that we have performed some work. */
     ksWorkUnitsCompleted++;
+#ifdef CONFIG_BENCHMARK_PREEMPTION_LATENCY
+    benchmark_preemption_point();
+#endif
 
     /*
      * If we have performed a non-trivial amount of work since last time we
@@ -28,12 +32,18 @@ exception_t preemptionPoint(void)
      */
     if (ksWorkUnitsCompleted >= CONFIG_MAX_NUM_WORK_UNITS_PER_PREEMPTION) {
         ksWorkUnitsCompleted = 0;
+#ifdef CONFIG_BENCHMARK_PREEMPTION_LATENCY
+        benchmark_preemption_irq_check();
+#endif
 #ifdef CONFIG_KERNEL_MCS
         updateTimestamp();
         if (isIRQPending() || isCurDomainExpired()
             || !(sc_active(NODE_STATE(ksCurSC)) && refill_sufficient(NODE_STATE(ksCurSC), NODE_STATE(ksConsumed)))) {
 #else
         if (isIRQPending()) {
+#endif
+#ifdef CONFIG_BENCHMARK_PREEMPTION_LATENCY
+            benchmark_preemption_preempted();
 #endif
             return EXCEPTION_PREEMPTED;
         }
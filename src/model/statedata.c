@@ -69,7 +69,38 @@ UP_STATE_DEFINE(timestamp_t, benchmark_end_time);
 UP_STATE_DEFINE(timestamp_t, benchmark_kernel_time);
 UP_STATE_DEFINE(timestamp_t, benchmark_kernel_number_entries);
 UP_STATE_DEFINE(timestamp_t, benchmark_kernel_number_schedules);
+UP_STATE_DEFINE(timestamp_t, benchmark_exit_time);
+UP_STATE_DEFINE(uint64_t, benchmark_domain_utilisation[CONFIG_NUM_DOMAINS][BENCHMARK_DOMAIN_NUM_COUNTERS]);
+#ifdef CONFIG_KERNEL_MCS
+UP_STATE_DEFINE(benchmark_sc_util_t, benchmark_sc_utilisation[CONFIG_BENCHMARK_TRACK_UTILISATION_SCHED_CONTEXTS]);
+UP_STATE_DEFINE(word_t, benchmark_sc_utilisation_overflow);
+#endif /* CONFIG_KERNEL_MCS */
+#ifdef CONFIG_BENCHMARK_TRACK_UTILISATION_PMU
+UP_STATE_DEFINE(uint32_t, benchmark_pmu_enter[BENCHMARK_PMU_NUM_EVENTS]);
+UP_STATE_DEFINE(uint32_t, benchmark_pmu_exit[BENCHMARK_PMU_NUM_EVENTS]);
+#endif /* CONFIG_BENCHMARK_TRACK_UTILISATION_PMU */
 #endif /* CONFIG_BENCHMARK_TRACK_UTILISATION */
+#ifdef CONFIG_BENCHMARK_TRACK_KERNEL_ENTRIES_RING
+UP_STATE_DEFINE(word_t, ksLogRingSlot);
+#endif /* CONFIG_BENCHMARK_TRACK_KERNEL_ENTRIES_RING */
+#ifdef CONFIG_BENCHMARK_SAMPLE_PROFILE
+UP_STATE_DEFINE(word_t, ksLogSampleCount);
+#endif /* CONFIG_BENCHMARK_SAMPLE_PROFILE */
+#ifdef CONFIG_BENCHMARK_SCHED_TRACE
+UP_STATE_DEFINE(word_t, ksLogSchedCount);
+#endif /* CONFIG_BENCHMARK_SCHED_TRACE */
+#ifdef CONFIG_BENCHMARK_FASTPATH_COUNTERS
+UP_STATE_DEFINE(uint64_t, ksFastpathCounters[BENCHMARK_FASTPATH_NUM_PATHS][BENCHMARK_FASTPATH_NUM_COUNTERS]);
+#endif /* CONFIG_BENCHMARK_FASTPATH_COUNTERS */
+#ifdef CONFIG_BENCHMARK_IRQ_LATENCY
+UP_STATE_DEFINE(benchmark_irq_latency_pending_t, ksIRQLatency);
+#endif /* CONFIG_BENCHMARK_IRQ_LATENCY */
+#ifdef CONFIG_BENCHMARK_PREEMPTION_LATENCY
+UP_STATE_DEFINE(uint64_t, ksPreemptionCounters[BENCHMARK_PREEMPTION_NUM_OPS][BENCHMARK_PREEMPTION_NUM_COUNTERS]);
+UP_STATE_DEFINE(word_t, ksPreemptionOp);
+UP_STATE_DEFINE(timestamp_t, ksPreemptionLastPoint);
+UP_STATE_DEFINE(timestamp_t, ksPreemptionLastCheck);
+#endif /* CONFIG_BENCHMARK_PREEMPTION_LATENCY */
 
 /* Units of work we have completed since the last time we checked for
  * pending interrupts */
@@ -20,6 +20,7 @@
 #include <kernel/thread.h>
 #include <model/preemption.h>
 #include <model/statedata.h>
+#include <benchmark/benchmark_preemption.h>
 #include <util.h>
 
 struct finaliseSlot_ret {
@@ -314,7 +315,16 @@ exception_t decodeCNodeInvocation(word_t invLabel, word_t length, cap_t cap,
 
 exception_t invokeCNodeRevoke(cte_t *destSlot)
 {
-    return cteRevoke(destSlot);
+    exception_t status;
+#ifdef CONFIG_BENCHMARK_PREEMPTION_LATENCY
+    word_t prev_op = benchmark_preemption_op(BENCHMARK_PREEMPTION_OP_REVOKE);
+#endif
+
+    status = cteRevoke(destSlot);
+#ifdef CONFIG_BENCHMARK_PREEMPTION_LATENCY
+    benchmark_preemption_op(prev_op);
+#endif
+    return status;
 }
 
 exception_t invokeCNodeDelete(cte_t *destSlot)
@@ -525,16 +535,149 @@ void cteSwap(cap_t cap1, cte_t *slot1, cap_t cap2, cte_t *slot2)
             CTE_REF(slot1));
 }
 
+#ifdef CONFIG_KERNEL_FAST_REVOKE
+/* Caps of these types have nothing to finalise unless they are the final
+ * capability to their object, so a non-final copy can simply be unlinked
+ * from the MDB without going through finaliseSlot. */
+static inline bool_t CONST capTrivialNonFinalDelete(cap_t cap)
+{
+    switch (cap_get_capType(cap)) {
+    case cap_endpoint_cap:
+    case cap_notification_cap:
+    case cap_reply_cap:
+    case cap_cnode_cap:
+    case cap_thread_cap:
+    case cap_irq_handler_cap:
+    case cap_domain_cap:
+#ifdef CONFIG_KERNEL_MCS
+    case cap_sched_context_cap:
+#endif
+        return true;
+    default:
+        return false;
+    }
+}
+
+/* isMDBParentOf(slot, child) for a revocable parent whose type needs no
+ * finalisation. For endpoints and notifications, the parent's object and
+ * badge are looked up once per revocation rather than for every child. */
+static inline bool_t revokeIsCopy(cte_t *slot, word_t type, word_t object, word_t badge, cte_t *child)
+{
+    switch (type) {
+    case cap_endpoint_cap:
+        return cap_get_capType(child->cap) == cap_endpoint_cap &&
+               cap_endpoint_cap_get_capEPPtr(child->cap) == object &&
+               (badge == 0 || (cap_endpoint_cap_get_capEPBadge(child->cap) == badge &&
+                               !mdb_node_get_mdbFirstBadged(child->cteMDBNode)));
+    case cap_notification_cap:
+        return cap_get_capType(child->cap) == cap_notification_cap &&
+               cap_notification_cap_get_capNtfnPtr(child->cap) == object &&
+               (badge == 0 || (cap_notification_cap_get_capNtfnBadge(child->cap) == badge &&
+                               !mdb_node_get_mdbFirstBadged(child->cteMDBNode)));
+    default:
+        return isMDBParentOf(slot, child);
+    }
+}
+
+/* Revoke a cap whose type needs no finalisation. Its children are copies of
+ * the same object and, as the parent stays in place, none of them is final.
+ * They directly follow the parent in the MDB, so up to
+ * CONFIG_REVOKE_BATCH_SIZE of them are unlinked at once and charged as one
+ * unit of work. */
+static exception_t cteRevokeCopies(cte_t *slot)
+{
+    word_t type = cap_get_capType(slot->cap);
+    word_t object = 0;
+    word_t badge = 0;
+    exception_t status;
+
+    if (type == cap_endpoint_cap) {
+        object = cap_endpoint_cap_get_capEPPtr(slot->cap);
+        badge = cap_endpoint_cap_get_capEPBadge(slot->cap);
+    } else if (type == cap_notification_cap) {
+        object = cap_notification_cap_get_capNtfnPtr(slot->cap);
+        badge = cap_notification_cap_get_capNtfnBadge(slot->cap);
+    }
+
+    while (true) {
+        cte_t *first, *next, *cur;
+        bool_t firstBadged = false;
+        word_t count;
+
+        first = CTE_PTR(mdb_node_get_mdbNext(slot->cteMDBNode));
+        next = first;
+        for (count = 0; count < CONFIG_REVOKE_BATCH_SIZE && next &&
+             revokeIsCopy(slot, type, object, badge, next); count++) {
+            firstBadged = firstBadged || mdb_node_get_mdbFirstBadged(next->cteMDBNode);
+            next = CTE_PTR(mdb_node_get_mdbNext(next->cteMDBNode));
+        }
+        if (count == 0) {
+            return EXCEPTION_NONE;
+        }
+
+        /* Same as calling emptySlot on each of them in turn */
+        mdb_node_ptr_set_mdbNext(&slot->cteMDBNode, CTE_REF(next));
+        if (next) {
+            mdb_node_ptr_set_mdbPrev(&next->cteMDBNode, CTE_REF(slot));
+            mdb_node_ptr_set_mdbFirstBadged(&next->cteMDBNode,
+                                            mdb_node_get_mdbFirstBadged(next->cteMDBNode) || firstBadged);
+        }
+        while (first != next) {
+            cur = first;
+            first = CTE_PTR(mdb_node_get_mdbNext(cur->cteMDBNode));
+            cur->cap = cap_null_cap_new();
+            cur->cteMDBNode = nullMDBNode;
+        }
+
+        status = preemptionPoint();
+        if (status != EXCEPTION_NONE) {
+            return status;
+        }
+    }
+}
+#endif
+
 exception_t cteRevoke(cte_t *slot)
 {
     cte_t *nextPtr;
     exception_t status;
+#ifdef CONFIG_KERNEL_FAST_REVOKE
+    word_t batched = 0;
+
+    /* only revocable slots can have MDB children */
+    if (!mdb_node_get_mdbRevocable(slot->cteMDBNode)) {
+        return EXCEPTION_NONE;
+    }
+    if (capTrivialNonFinalDelete(slot->cap)) {
+        return cteRevokeCopies(slot);
+    }
+#endif
 
     /* there is no need to check for a NullCap as NullCaps are
        always accompanied by null mdb pointers */
     for (nextPtr = CTE_PTR(mdb_node_get_mdbNext(slot->cteMDBNode));
          nextPtr && isMDBParentOf(slot, nextPtr);
          nextPtr = CTE_PTR(mdb_node_get_mdbNext(slot->cteMDBNode))) {
+#ifdef CONFIG_KERNEL_FAST_REVOKE
+        /* Children that need no finalisation and are not the final cap to
+         * their object, e.g. the copies of an endpoint retyped from an
+         * untyped, are detached directly, and a batch of them is charged as
+         * a single unit of work. */
+        if (capTrivialNonFinalDelete(nextPtr->cap) && !isFinalCapability(nextPtr)) {
+            emptySlot(nextPtr, cap_null_cap_new());
+            batched++;
+            if (batched < CONFIG_REVOKE_BATCH_SIZE) {
+                continue;
+            }
+            batched = 0;
+            status = preemptionPoint();
+            if (status != EXCEPTION_NONE) {
+                return status;
+            }
+            continue;
+        }
+        batched = 0;
+#endif
         status = cteDelete(nextPtr, true);
         if (status != EXCEPTION_NONE) {
             return status;
@@ -552,8 +695,14 @@ exception_t cteRevoke(cte_t *slot)
 exception_t cteDelete(cte_t *slot, bool_t exposed)
 {
     finaliseSlot_ret_t fs_ret;
+#ifdef CONFIG_BENCHMARK_PREEMPTION_LATENCY
+    word_t prev_op = benchmark_preemption_op(BENCHMARK_PREEMPTION_OP_DELETE);
+#endif
 
     fs_ret = finaliseSlot(slot, exposed);
+#ifdef CONFIG_BENCHMARK_PREEMPTION_LATENCY
+    benchmark_preemption_op(prev_op);
+#endif
     if (fs_ret.status != EXCEPTION_NONE) {
         return fs_ret.status;
     }
@@ -11,6 +11,7 @@
 #include <kernel/vspace.h>
 #include <machine/registerset.h>
 #include <model/statedata.h>
+#include <benchmark/benchmark_preemption.h>
 #include <object/notification.h>
 #include <object/cnode.h>
 #include <object/endpoint.h>
@@ -397,6 +398,9 @@ static inline void restart_thread_if_no_fault(tcb_t *thread)
 
 void cancelAllIPC(endpoint_t *epptr)
 {
+#ifdef CONFIG_BENCHMARK_PREEMPTION_LATENCY
+    word_t prev_op = benchmark_preemption_op(BENCHMARK_PREEMPTION_OP_CANCEL_IPC);
+#endif
     switch (endpoint_ptr_get_state(epptr)) {
     case EPState_Idle:
         break;
@@ -427,10 +431,16 @@ void cancelAllIPC(endpoint_t *epptr)
         break;
     }
     }
+#ifdef CONFIG_BENCHMARK_PREEMPTION_LATENCY
+    benchmark_preemption_op(prev_op);
+#endif
 }
 
 void cancelBadgedSends(endpoint_t *epptr, word_t badge)
 {
+#ifdef CONFIG_BENCHMARK_PREEMPTION_LATENCY
+    word_t prev_op = benchmark_preemption_op(BENCHMARK_PREEMPTION_OP_CANCEL_IPC);
+#endif
     switch (endpoint_ptr_get_state(epptr)) {
     case EPState_Idle:
     case EPState_Recv:
@@ -480,6 +490,9 @@ void cancelBadgedSends(endpoint_t *epptr, word_t badge)
     default:
         fail("invalid EP state");
     }
+#ifdef CONFIG_BENCHMARK_PREEMPTION_LATENCY
+    benchmark_preemption_op(prev_op);
+#endif
 }
 
 #ifdef CONFIG_KERNEL_MCS
@@ -17,6 +17,7 @@
 #include <kernel/cspace.h>
 #include <kernel/thread.h>
 #include <model/statedata.h>
+#include <benchmark/benchmark_irq.h>
 #include <machine/timer.h>
 #include <smp/ipi.h>
 
@@ -201,6 +202,10 @@ void handleInterrupt(irq_t irq)
         return;
     }
 
+#ifdef CONFIG_BENCHMARK_IRQ_LATENCY
+    benchmark_irq_latency_dispatch(IRQT_TO_IRQ(irq));
+#endif
+
     switch (intStateIRQTable[IRQT_TO_IDX(irq)]) {
     case IRQSignal: {
         /* Merging the variable declaration and initialization into one line
@@ -212,6 +217,9 @@ void handleInterrupt(irq_t irq)
             cap_notification_cap_get_capNtfnCanSend(cap)) {
             sendSignal(NTFN_PTR(cap_notification_cap_get_capNtfnPtr(cap)),
                        cap_notification_cap_get_capNtfnBadge(cap));
+#ifdef CONFIG_BENCHMARK_IRQ_LATENCY
+            benchmark_irq_latency_signal();
+#endif
         } else {
 #ifdef CONFIG_IRQ_REPORTING
             printf("Undelivered IRQ: %d\n", (int)IRQT_TO_IRQ(irq));
@@ -12,6 +12,8 @@
 #include <object/tcb.h>
 #include <object/endpoint.h>
 #include <model/statedata.h>
+#include <benchmark/benchmark_preemption.h>
+#include <benchmark/benchmark_irq.h>
 #include <machine/io.h>
 
 #include <object/notification.h>
@@ -71,6 +73,9 @@ void sendSignal(notification_t *ntfnPtr, word_t badge)
                 cancelIPC(tcb);
                 setThreadState(tcb, ThreadState_Running);
                 setRegister(tcb, badgeRegister, badge);
+#ifdef CONFIG_BENCHMARK_IRQ_LATENCY
+                benchmark_irq_latency_wake(tcb);
+#endif
                 MCS_DO_IF_SC(tcb, ntfnPtr, {
                     possibleSwitchTo(tcb);
                 })
@@ -99,6 +104,9 @@ void sendSignal(notification_t *ntfnPtr, word_t badge)
                     setThreadState(tcb, ThreadState_Running);
                     setRegister(tcb, badgeRegister, badge);
                     Arch_leaveVMAsyncTransfer(tcb);
+#ifdef CONFIG_BENCHMARK_IRQ_LATENCY
+                    benchmark_irq_latency_wake(tcb);
+#endif
                     MCS_DO_IF_SC(tcb, ntfnPtr, {
                         possibleSwitchTo(tcb);
                     })
@@ -155,6 +163,9 @@ void sendSignal(notification_t *ntfnPtr, word_t badge)
 
         setThreadState(dest, ThreadState_Running);
         setRegister(dest, badgeRegister, badge);
+#ifdef CONFIG_BENCHMARK_IRQ_LATENCY
+        benchmark_irq_latency_wake(dest);
+#endif
         MCS_DO_IF_SC(dest, ntfnPtr, {
             possibleSwitchTo(dest);
         })
@@ -242,6 +253,9 @@ void receiveSignal(tcb_t *thread, cap_t cap, bool_t isBlocking)
 
 void cancelAllSignals(notification_t *ntfnPtr)
 {
+#ifdef CONFIG_BENCHMARK_PREEMPTION_LATENCY
+    word_t prev_op = benchmark_preemption_op(BENCHMARK_PREEMPTION_OP_CANCEL_SIGNALS);
+#endif
     if (notification_ptr_get_state(ntfnPtr) == NtfnState_Waiting) {
         tcb_t *thread = TCB_PTR(notification_ptr_get_ntfnQueue_head(ntfnPtr));
 
@@ -271,6 +285,9 @@ void cancelAllSignals(notification_t *ntfnPtr)
         }
         rescheduleRequired();
     }
+#ifdef CONFIG_BENCHMARK_PREEMPTION_LATENCY
+    benchmark_preemption_op(prev_op);
+#endif
 }
 
 void cancelSignal(tcb_t *threadPtr, notification_t *ntfnPtr)
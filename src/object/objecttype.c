@@ -231,6 +231,9 @@ finaliseCap_ret_t finaliseCap(cap_t cap, bool_t final, bool_t exposed)
             /* mark the sc as no longer valid */
             sc->scRefillMax = 0;
             sc->scSporadic = false;
+#ifdef CONFIG_BENCHMARK_TRACK_UTILISATION
+            benchmark_sc_utilisation_remove(sc);
+#endif
             fc_ret.remainder = cap_null_cap_new();
             fc_ret.cleanupInfo = cap_null_cap_new();
             return fc_ret;
@@ -16,6 +16,7 @@
 #include <object/cnode.h>
 #include <kernel/cspace.h>
 #include <kernel/thread.h>
+#include <benchmark/benchmark_preemption.h>
 #include <util.h>
 
 static word_t alignUp(word_t baseValue, word_t alignment)
@@ -282,7 +283,13 @@ exception_t invokeUntyped_Retype(cte_t *srcSlot,
     exception_t status;
 
     if (reset) {
+#ifdef CONFIG_BENCHMARK_PREEMPTION_LATENCY
+        word_t prev_op = benchmark_preemption_op(BENCHMARK_PREEMPTION_OP_RESET_UNTYPED);
+#endif
         status = resetUntypedCap(srcSlot);
+#ifdef CONFIG_BENCHMARK_PREEMPTION_LATENCY
+        benchmark_preemption_op(prev_op);
+#endif
         if (status != EXCEPTION_NONE) {
             return status;
         }
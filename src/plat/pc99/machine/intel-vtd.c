@@ -30,12 +30,19 @@
 #define FEADDR_REG  0x40
 #define FEUADDR_REG 0x44
 #define CAP_REG     0x08
+#define IQH_REG     0x80
+#define IQT_REG     0x88
+#define IQA_REG     0x90
 
 /* Bit Positions within Registers */
 #define SRTP        30  /* Set Root Table Pointer */
 #define RTPS        30  /* Root Table Pointer Status */
 #define TE          31  /* Translation Enable */
 #define TES         31  /* Translation Enable Status */
+#define QIE         26  /* Queued Invalidation Enable */
+#define QIES        26  /* Queued Invalidation Enable Status */
+#define QI          1   /* Queued Invalidation support in ECAP_REG */
+#define PSI         7   /* Page Selective Invalidation support, high word of CAP_REG */
 
 /* ICC is 63rd bit in CCMD_REG, but since we will be
  * accessing this register as 4 byte word, ICC becomes
@@ -67,6 +74,9 @@
 #define NFR_MASK    0xff
 #define PPF         1
 #define PPF_MASK    1
+#define IQE         4   /* Invalidation Queue Error, in FSTS_REG */
+#define ICE         5   /* Invalidation Completion Error, in FSTS_REG */
+#define ITE         6   /* Invalidation Time-out Error, in FSTS_REG */
 #define PRESENT     1
 #define WBF         27
 #define WBFS        27
@@ -86,6 +96,28 @@
 #define DMA_TLB_READ_DRAIN  BIT(17)
 #define DMA_TLB_WRITE_DRAIN BIT(16)
 
+#ifdef CONFIG_IOMMU_QUEUED_INVALIDATION
+/* Each queue is a single page of 128-bit descriptors, which is queue size 0 in
+ * IQA_REG. The tail register holds the byte offset of the next descriptor. */
+#define N_VTD_INV_DESC          256
+#define VTD_INV_DESC_SIZE_BITS  4
+#define VTD_INV_DESC_WORDS      2
+
+#define INV_DESC_CONTEXT        0x1
+#define INV_DESC_IOTLB          0x2
+#define INV_DESC_WAIT           0x5
+#define INV_DESC_GRANULARITY    4
+#define INV_DESC_DID            16
+#define INV_DESC_IOTLB_DW       BIT(6)
+#define INV_DESC_IOTLB_DR       BIT(7)
+#define INV_DESC_WAIT_SW        BIT(5)
+#define INV_DESC_WAIT_DATA      32
+
+#define INV_GLOBAL              0x1
+#define INV_DOMAIN              0x2
+#define INV_PAGE                0x3
+#endif
+
 #define N_VTD_CONTEXTS 256
 
 typedef uint32_t drhu_id_t;
@@ -131,6 +163,11 @@ static uint32_t get_fro_offset(drhu_id_t drhu_id)
 
 void invalidate_context_cache(void)
 {
+#ifdef CONFIG_IOMMU_QUEUED_INVALIDATION
+    /* The command registers must not be used once queued invalidation is enabled */
+    assert(!x86KSvtdQueuedInvalidation);
+#endif
+
     /* FIXME - bugzilla bug 172
      * 1. Instead of assuming global invalidation, this function should
      *    accept a parameter to control the granularity of invalidation
@@ -171,6 +208,10 @@ void invalidate_iotlb(void)
      *    device.
      */
 
+#ifdef CONFIG_IOMMU_QUEUED_INVALIDATION
+    assert(!x86KSvtdQueuedInvalidation);
+#endif
+
     uint8_t   invalidate_command = IOTLB_GLOBAL_INVALIDATE;
     uint32_t  iotlb_reg_upper;
     uint32_t  ivo_offset;
@@ -199,6 +240,161 @@ void invalidate_iotlb(void)
     }
 }
 
+#ifdef CONFIG_IOMMU_QUEUED_INVALIDATION
+static inline uint64_t *vtd_inv_desc(drhu_id_t drhu_id, word_t index)
+{
+    return x86KSvtdInvQueue + (drhu_id << (PAGE_BITS - 3)) + (index % N_VTD_INV_DESC) * VTD_INV_DESC_WORDS;
+}
+
+static void vtd_inv_desc_write(drhu_id_t drhu_id, word_t index, uint64_t lo, uint64_t hi)
+{
+    uint64_t *desc = vtd_inv_desc(drhu_id, index);
+
+    desc[0] = lo;
+    desc[1] = hi;
+    flushCacheRange(desc, VTD_INV_DESC_SIZE_BITS);
+}
+
+static void vtd_queue_invalidation(uint64_t lo, uint64_t hi)
+{
+    /* Keep one slot free for the wait descriptor, and one more so that a full
+     * queue is never mistaken for an empty one */
+    if (x86KSvtdInvQueueTail - x86KSvtdInvQueueHead >= N_VTD_INV_DESC - 2) {
+        vtd_flush_invalidations();
+    }
+
+    /* Every IOMMU receives the same descriptors, as we do not track which
+     * IOMMU is responsible for which device */
+    for (drhu_id_t i = 0; i < x86KSnumDrhu; i++) {
+        vtd_inv_desc_write(i, x86KSvtdInvQueueTail, lo, hi);
+    }
+    x86KSvtdInvQueueTail++;
+}
+
+/* The IOMMU stops fetching descriptors on an invalidation error, so a wait
+ * descriptor queued behind the failed one never completes. The kernel only
+ * queues descriptors it built itself, and none that invalidate device TLBs,
+ * so any of these errors means the IOMMU can no longer be relied on to isolate
+ * DMA, and the kernel halts. */
+static void vtd_check_invalidation_errors(drhu_id_t i)
+{
+    uint32_t fsts = vtd_read32(i, FSTS_REG);
+
+    if (fsts & (BIT(IQE) | BIT(ICE) | BIT(ITE))) {
+        printf("IOMMU 0x%x: invalidation %s at queue head 0x%lx\n", i,
+               (fsts & BIT(IQE)) ? "queue error" : (fsts & BIT(ITE)) ? "time-out" : "completion error",
+               (long)(vtd_read64(i, IQH_REG) >> VTD_INV_DESC_SIZE_BITS));
+        halt();
+    }
+}
+
+void vtd_flush_invalidations(void)
+{
+    drhu_id_t i;
+
+    if (x86KSvtdInvQueueTail == x86KSvtdInvQueueHead) {
+        return;
+    }
+
+    /* A single wait descriptor per IOMMU covers everything queued before it */
+    for (i = 0; i < x86KSnumDrhu; i++) {
+        x86KSvtdInvStatus[i] = 0;
+        vtd_inv_desc_write(i, x86KSvtdInvQueueTail,
+                           INV_DESC_WAIT | INV_DESC_WAIT_SW | ((uint64_t)1 << INV_DESC_WAIT_DATA),
+                           pptr_to_paddr(&x86KSvtdInvStatus[i]));
+    }
+    x86KSvtdInvQueueTail++;
+
+    /* Submit to all IOMMUs before waiting on any of them */
+    for (i = 0; i < x86KSnumDrhu; i++) {
+        vtd_write64(i, IQT_REG, (x86KSvtdInvQueueTail % N_VTD_INV_DESC) << VTD_INV_DESC_SIZE_BITS);
+    }
+    for (i = 0; i < x86KSnumDrhu; i++) {
+        while (*(volatile uint32_t *)&x86KSvtdInvStatus[i] == 0) {
+            vtd_check_invalidation_errors(i);
+        }
+    }
+    x86KSvtdInvQueueHead = x86KSvtdInvQueueTail;
+}
+
+void vtd_invalidate_iotlb_page(uint16_t domain_id, word_t io_address)
+{
+    if (!x86KSvtdQueuedInvalidation) {
+        invalidate_iotlb();
+        return;
+    }
+    if (!x86KSvtdPageSelectiveInvalidation) {
+        vtd_invalidate_iotlb_domain(domain_id);
+        return;
+    }
+    vtd_queue_invalidation(INV_DESC_IOTLB | (INV_PAGE << INV_DESC_GRANULARITY) |
+                           INV_DESC_IOTLB_DR | INV_DESC_IOTLB_DW | ((uint64_t)domain_id << INV_DESC_DID),
+                           (uint64_t)(io_address & ~MASK(seL4_PageBits)));
+}
+
+void vtd_invalidate_iotlb_domain(uint16_t domain_id)
+{
+    if (!x86KSvtdQueuedInvalidation) {
+        invalidate_iotlb();
+        return;
+    }
+    vtd_queue_invalidation(INV_DESC_IOTLB | (INV_DOMAIN << INV_DESC_GRANULARITY) |
+                           INV_DESC_IOTLB_DR | INV_DESC_IOTLB_DW | ((uint64_t)domain_id << INV_DESC_DID),
+                           0);
+}
+
+void vtd_invalidate_context_domain(uint16_t domain_id)
+{
+    if (!x86KSvtdQueuedInvalidation) {
+        invalidate_context_cache();
+        return;
+    }
+    vtd_queue_invalidation(INV_DESC_CONTEXT | (INV_DOMAIN << INV_DESC_GRANULARITY) |
+                           ((uint64_t)domain_id << INV_DESC_DID),
+                           0);
+}
+
+BOOT_CODE static void vtd_enable_queued_invalidation(void)
+{
+    drhu_id_t i;
+    uint32_t status;
+
+    x86KSvtdQueuedInvalidation = true;
+    x86KSvtdPageSelectiveInvalidation = true;
+    for (i = 0; i < x86KSnumDrhu; i++) {
+        if (!((vtd_read32(i, ECAP_REG) >> QI) & 1)) {
+            x86KSvtdQueuedInvalidation = false;
+        }
+        if (!((vtd_read32(i, CAP_REG + 4) >> PSI) & 1)) {
+            x86KSvtdPageSelectiveInvalidation = false;
+        }
+    }
+
+    if (!x86KSvtdQueuedInvalidation) {
+        printf("IOMMU: queued invalidation not supported, using register based invalidation\n");
+        return;
+    }
+
+    x86KSvtdInvQueueHead = 0;
+    x86KSvtdInvQueueTail = 0;
+    for (i = 0; i < x86KSnumDrhu; i++) {
+        vtd_write64(i, IQT_REG, 0);
+        /* Queue size 0 is a single page of 256 descriptors */
+        vtd_write64(i, IQA_REG, pptr_to_paddr(vtd_inv_desc(i, 0)));
+
+        status = vtd_read32(i, GSTS_REG);
+        status |= BIT(QIE);
+        /* Enable queued invalidation by setting QIE bit in GCMD_REG */
+        vtd_write32(i, GCMD_REG, status);
+
+        /* Wait for the invalidation queue to be enabled by polling
+         * QIES bit from GSTS_REG
+         */
+        while (!((vtd_read32(i, GSTS_REG) >> QIES) & 1));
+    }
+}
+#endif /* CONFIG_IOMMU_QUEUED_INVALIDATION */
+
 static void vtd_clear_fault(drhu_id_t i, word_t fr_reg)
 {
     /* Clear the 'F' (Fault) bit to indicate that this fault is processed */
@@ -275,6 +471,10 @@ BOOT_CODE word_t vtd_get_n_paging(acpi_rmrr_list_t *rmrr_list)
     word_t size = 1; /* one for the root table */
     size += N_VTD_CONTEXTS; /* one for each context */
     size += rmrr_list->num; /* one for each device */
+#ifdef CONFIG_IOMMU_QUEUED_INVALIDATION
+    size += x86KSnumDrhu; /* one invalidation queue for each IOMMU */
+    size += 1; /* one for the wait descriptor status words */
+#endif
 
     if (rmrr_list->num == 0) {
         return size;
@@ -419,6 +619,11 @@ BOOT_CODE static bool_t vtd_enable(cpu_id_t cpu_id)
     /* Globally invalidate IOTLB of all IOMMUs */
     invalidate_iotlb();
 
+#ifdef CONFIG_IOMMU_QUEUED_INVALIDATION
+    /* From here on the command registers must not be used for invalidation */
+    vtd_enable_queued_invalidation();
+#endif
+
     for (i = 0; i < x86KSnumDrhu; i++) {
         uint32_t data, addr;
 
@@ -522,6 +727,16 @@ BOOT_CODE bool_t vtd_init(cpu_id_t  cpu_id, acpi_rmrr_list_t *rmrr_list)
     }
 
     x86KSvtdRootTable = (vtd_rte_t *) it_alloc_paging();
+#ifdef CONFIG_IOMMU_QUEUED_INVALIDATION
+    /* The queues are allocated back to back so they can be indexed by IOMMU */
+    x86KSvtdInvQueue = (uint64_t *) it_alloc_paging();
+    for (drhu_id_t i = 1; i < x86KSnumDrhu; i++) {
+        UNUSED pptr_t queue = it_alloc_paging();
+        assert(queue == (pptr_t)x86KSvtdInvQueue + (i << PAGE_BITS));
+    }
+    x86KSvtdInvStatus = (uint32_t *) it_alloc_paging();
+    assert(x86KSnumDrhu <= BIT(PAGE_BITS) / sizeof(uint32_t));
+#endif
     for (uint32_t bus = 0; bus < N_VTD_CONTEXTS; bus++) {
         vtd_create_context_table(bus, rmrr_list);
     }
@@ -84,6 +84,9 @@ void handleIPI(irq_t irq, bool_t irqPath)
     if (IRQT_TO_IRQ(irq) == irq_remote_call_ipi) {
         handleRemoteCall(remoteCall, get_ipi_arg(0), get_ipi_arg(1), get_ipi_arg(2), irqPath);
     } else if (IRQT_TO_IRQ(irq) == irq_reschedule_ipi) {
+#ifdef CONFIG_ARM_HYP_VIRQ_ASYNC
+        handleVCPUPostedInterruptsIPI();
+#endif
         rescheduleRequired();
 #ifdef CONFIG_ARCH_RISCV
         ifence_local();
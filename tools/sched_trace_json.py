@@ -0,0 +1,153 @@
+#!/usr/bin/env python3
+#
+# Copyright 2026, seL4 Project a Series of LF Projects, LLC
+#
+# SPDX-License-Identifier: BSD-2-Clause
+#
+
+"""
+Convert the log buffer of the sched_trace benchmark mode into the Chrome trace
+event format, which can be loaded into Perfetto or chrome://tracing.
+
+The input is a raw copy of the whole log buffer taken after
+seL4_BenchmarkFinalizeLog. The layout of the per-core logs is described in
+libsel4/include/sel4/benchmark_sched_types.h.
+"""
+
+import argparse
+import json
+import struct
+import sys
+
+LOG_HEADER = struct.Struct('<QQ')
+EVENT = struct.Struct('<QQQII')
+
+SWITCH, WAKE, BLOCK, DOMAIN, BUDGET, POSTPONE, RELEASE = range(7)
+
+THREAD_STATES = ['Inactive', 'Running', 'Restart', 'BlockedOnReceive', 'BlockedOnSend',
+                 'BlockedOnReply', 'BlockedOnNotification']
+
+IDLE_PRIORITY = (1 << 64) - 1
+
+RUNNING_TID = 0
+EVENTS_TID = 1
+
+
+def thread_state(state):
+    """ Name of a thread state, which may be a configuration dependent one """
+    if state < len(THREAD_STATES):
+        return THREAD_STATES[state]
+    return 'state %d' % state
+
+
+def read_logs(data, cores):
+    """ Yield the events of each core's log, and report dropped events """
+    log_size = len(data) // cores
+    for core in range(cores):
+        base = core * log_size
+        count, dropped = LOG_HEADER.unpack_from(data, base)
+        max_count = (log_size - LOG_HEADER.size) // EVENT.size
+        if count > max_count:
+            raise ValueError('core %d: log claims %d events but only fits %d, '
+                             'is the number of cores right?' % (core, count, max_count))
+        if dropped:
+            print('core %d: %d events dropped as the log was full' % (core, dropped),
+                  file=sys.stderr)
+        for i in range(count):
+            yield EVENT.unpack_from(data, base + LOG_HEADER.size + i * EVENT.size)
+
+
+def convert(events, names, cycles_per_us):
+    """ Turn (time, tcb, arg, type, core) tuples into trace events """
+    def name(tcb):
+        return names.get('0x%x' % tcb, '0x%x' % tcb)
+
+    def us(time):
+        return (time - start) / cycles_per_us
+
+    events = sorted(events, key=lambda e: (e[0], e[4]))
+    if not events:
+        return []
+    start = events[0][0]
+
+    trace = []
+    running = {}
+    for time, tcb, arg, kind, core in events:
+        if core not in running:
+            trace.append({'name': 'process_name', 'ph': 'M', 'pid': core,
+                          'args': {'name': 'core %d' % core}})
+            trace.append({'name': 'thread_name', 'ph': 'M', 'pid': core, 'tid': RUNNING_TID,
+                          'args': {'name': 'running'}})
+            trace.append({'name': 'thread_name', 'ph': 'M', 'pid': core, 'tid': EVENTS_TID,
+                          'args': {'name': 'events'}})
+            running[core] = None
+
+        instant = {'ph': 'i', 's': 't', 'pid': core, 'tid': EVENTS_TID, 'ts': us(time),
+                   'args': {'tcb': '0x%x' % tcb}}
+        if kind == SWITCH:
+            if running[core] is not None:
+                slice_start, slice_args = running[core]
+                slice_args['dur'] = us(time) - slice_start
+                trace.append(slice_args)
+            idle = arg == IDLE_PRIORITY
+            slice_args = {'name': 'idle' if idle else name(tcb), 'ph': 'X', 'pid': core,
+                          'tid': RUNNING_TID, 'ts': us(time), 'args': {'tcb': '0x%x' % tcb}}
+            if not idle:
+                slice_args['args']['priority'] = arg
+            running[core] = (us(time), slice_args)
+        elif kind == DOMAIN:
+            trace.append({'name': 'domain', 'ph': 'C', 'pid': core, 'ts': us(time),
+                          'args': {'domain': arg}})
+        elif kind in (WAKE, BLOCK):
+            instant['name'] = '%s %s' % ('wake' if kind == WAKE else 'block', name(tcb))
+            instant['args']['state'] = thread_state(arg)
+            trace.append(instant)
+        elif kind == BUDGET:
+            instant['name'] = 'charge %s' % name(tcb)
+            instant['args']['consumed'] = arg
+            trace.append(instant)
+        elif kind == POSTPONE:
+            instant['name'] = 'postpone %s' % name(tcb)
+            instant['args']['release'] = arg
+            trace.append(instant)
+        elif kind == RELEASE:
+            instant['name'] = 'release %s' % name(tcb)
+            trace.append(instant)
+        else:
+            raise ValueError('unknown event type %d' % kind)
+
+    # Close the slices still running at the end of the trace
+    end = us(events[-1][0])
+    for core, current in running.items():
+        if current is not None:
+            slice_start, slice_args = current
+            slice_args['dur'] = end - slice_start
+            trace.append(slice_args)
+
+    return trace
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__,
+                                     formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument('log', type=argparse.FileType('rb'),
+                        help='raw copy of the log buffer')
+    parser.add_argument('--cores', type=int, default=1,
+                        help='value of KernelMaxNumNodes the kernel was built with')
+    parser.add_argument('--cycles-per-us', type=float, default=1.0,
+                        help='timestamp() ticks per microsecond, to get a time scale in the trace')
+    parser.add_argument('--names', type=argparse.FileType('r'),
+                        help='JSON object mapping TCB kernel addresses, as "0x..." strings, '
+                        'to thread names')
+    parser.add_argument('--output', type=argparse.FileType('w'), default=sys.stdout,
+                        help='output file, standard output by default')
+    args = parser.parse_args()
+
+    names = json.load(args.names) if args.names else {}
+    trace = convert(read_logs(args.log.read(), args.cores), names, args.cycles_per_us)
+    json.dump({'traceEvents': trace, 'displayTimeUnit': 'ns'}, args.output)
+    return 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())